@@ -0,0 +1,96 @@
+// bench_rules.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_BENCH_RULES_HPP
+#define LEXERTL_BENCH_RULES_HPP
+
+#include <lexertl/rules.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// Rule sets shared by lexertl_bench and lexertl_bench_gen (which turns
+// them into table_based_cpp code). None of them use $ so that the
+// generated code can be built both with and without pointers.
+namespace bench
+{
+    // Keywords, identifiers, numbers, string and character literals,
+    // comments and operators.
+    inline void c_like_rules(lexertl::rules& rules_)
+    {
+        rules_.push("auto|break|case|char|const|continue|default|do|double|"
+            "else|enum|extern|float|for|goto|if|int|long|register|return|"
+            "short|signed|sizeof|static|struct|switch|typedef|union|"
+            "unsigned|void|volatile|while", 1);
+        rules_.push("[A-Za-z_][A-Za-z0-9_]*", 2);
+        rules_.push("0[xX][0-9a-fA-F]+|\\d+(\\.\\d+)?([eE][-+]?\\d+)?", 3);
+        rules_.push("\\\"([^\\\"\\\\\\n]|\\\\.)*\\\"", 4);
+        rules_.push("'([^'\\\\\\n]|\\\\.)+'", 5);
+        rules_.push("==|!=|<=|>=|&&|\\|\\||\\+\\+|--|->|<<|>>|"
+            "[-+*/%=<>!&|^~?:;,.(){}\\[\\]]", 6);
+        rules_.push("\\/\\*([^*]|\\*+[^*/])*\\*+\\/", rules_.skip());
+        rules_.push("\\/\\/.*", rules_.skip());
+        rules_.push("\\s+", rules_.skip());
+    }
+
+    // RFC 8259 tokens.
+    inline void json_rules(lexertl::rules& rules_)
+    {
+        rules_.push("[{}\\[\\]:,]", 1);
+        rules_.push("\\\"([^\\\"\\\\]|\\\\([\\\"\\\\/bfnrt]|u[0-9a-fA-F]{4}))*"
+            "\\\"", 2);
+        rules_.push("-?(0|[1-9]\\d*)(\\.\\d+)?([eE][-+]?\\d+)?", 3);
+        rules_.push("true|false|null", 4);
+        rules_.push("\\s+", rules_.skip());
+    }
+
+    // Apache/nginx combined log format.
+    inline void log_rules(lexertl::rules& rules_)
+    {
+        rules_.push("\\d{1,3}(\\.\\d{1,3}){3}", 1);
+        rules_.push("\\[[^\\]\\n]*\\]", 2);
+        rules_.push("\\\"([^\\\"\\\\\\n]|\\\\.)*\\\"", 3);
+        rules_.push("\\d+", 4);
+        rules_.push("-", 5);
+        rules_.push("\\n", 6);
+        rules_.push("[A-Za-z0-9_.:/-]+", 7);
+        rules_.push("[ \\t]+", rules_.skip());
+    }
+
+    // Case insensitive SQL with a large keyword set, each keyword having
+    // its own id.
+    inline void sql_rules(lexertl::rules& rules_)
+    {
+        static const char* keywords_[] = { "select", "from", "where",
+            "insert", "into", "values", "update", "set", "delete", "create",
+            "table", "index", "view", "drop", "alter", "add", "column",
+            "primary", "key", "foreign", "references", "unique", "not",
+            "null", "default", "and", "or", "in", "between", "like", "is",
+            "exists", "join", "inner", "left", "right", "outer", "full",
+            "cross", "on", "using", "group", "by", "order", "asc", "desc",
+            "having", "limit", "offset", "union", "all", "distinct", "as",
+            "case", "when", "then", "else", "end", "cast", "count", "sum",
+            "avg", "min", "max", "integer", "varchar", "char", "text",
+            "date", "timestamp", "boolean", "true", "false", "begin",
+            "commit", "rollback", "transaction", "with", "recursive" };
+        std::size_t id_ = 100;
+
+        rules_.flags(rules_.flags() | *lexertl::regex_flags::icase);
+
+        for (const char* kw_ : keywords_)
+        {
+            rules_.push(kw_, static_cast<uint16_t>(id_++));
+        }
+
+        rules_.push("[A-Za-z_][A-Za-z0-9_]*", 1);
+        rules_.push("\\d+(\\.\\d+)?", 2);
+        rules_.push("'([^']|'')*'", 3);
+        rules_.push("<>|!=|<=|>=|\\|\\||[-+*/%=<>(),.;]", 4);
+        rules_.push("--.*", rules_.skip());
+        rules_.push("\\s+", rules_.skip());
+    }
+}
+
+#endif
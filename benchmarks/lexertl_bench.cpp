@@ -0,0 +1,759 @@
+// lexertl_bench.cpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Usage: lexertl_bench [--size <MiB>] [--json <file>]
+//
+// Prints the throughput of each run (best of several) along with the time
+// taken by basic_generator::build() for each rule set. --json also writes
+// the results to <file> so that they can be compared between releases.
+#include "bench_rules.hpp"
+#include "lexertl_bench_generated.hpp"
+
+#include <lexertl/batch.hpp>
+#include <lexertl/flat_state_machine.hpp>
+#include <lexertl/generator.hpp>
+#include <lexertl/iterator.hpp>
+#include <lexertl/lookup.hpp>
+#include <lexertl/parallel.hpp>
+#include <lexertl/profile.hpp>
+#include <lexertl/replace.hpp>
+#include <lexertl/utf_iterators.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::size_t states_ = 48;
+    std::size_t input_size_ = 16 * 1024 * 1024;
+
+    struct throughput
+    {
+        std::string _name;
+        double _mb_per_s = 0;
+        double _tokens_per_s = 0;
+        std::size_t _tokens = 0;
+    };
+
+    struct build_time
+    {
+        std::string _name;
+        double _ms = 0;
+    };
+
+    std::vector<throughput> throughput_;
+    std::vector<build_time> build_time_;
+
+    // Best of several calls to generator::build(), reported in ms. sm_
+    // holds the last state machine built.
+    template<typename generator, typename rules_type, typename sm_type>
+    void timed_build(const char* name_, const rules_type& rules_,
+        sm_type& sm_)
+    {
+        using clock = std::chrono::steady_clock;
+        const int runs_ = 3;
+        double best_ = 0;
+
+        for (int i_ = 0; i_ < runs_; ++i_)
+        {
+            const auto start_ = clock::now();
+
+            sm_.clear();
+            generator::build(rules_, sm_);
+
+            const std::chrono::duration<double, std::milli> ms_ =
+                clock::now() - start_;
+
+            best_ = i_ == 0 ? ms_.count() : std::min(best_, ms_.count());
+        }
+
+        std::printf("%-44s %10.3f ms\n",
+            (std::string(name_) + "/build").c_str(), best_);
+        build_time_.push_back(build_time{ name_, best_ });
+    }
+
+    // Dozens of lexer states, each with its own keyword set, so that
+    // switching state touches a different set of tables every few tokens.
+    // "@n" switches to state n.
+    template<typename sm_type>
+    void build_multi_state(const char* label_, sm_type& sm_)
+    {
+        using id_type = typename sm_type::id_type;
+        lexertl::basic_rules<char, char, id_type> rules_;
+
+        for (std::size_t i_ = 1; i_ < states_; ++i_)
+        {
+            rules_.push_state(("S" + std::to_string(i_)).c_str());
+        }
+
+        for (std::size_t i_ = 0; i_ < states_; ++i_)
+        {
+            const std::string name_ = i_ == 0 ?
+                "INITIAL" : "S" + std::to_string(i_);
+            const std::string kw_ = "k" + std::to_string(i_);
+
+            rules_.push(name_.c_str(), (kw_ + "a|" + kw_ + "b|" + kw_ + "c").
+                c_str(), static_cast<id_type>(1), ".");
+            rules_.push(name_.c_str(), "[a-z_][a-z0-9_]*",
+                static_cast<id_type>(2), ".");
+            rules_.push(name_.c_str(), "\\d+(\\.\\d+)?",
+                static_cast<id_type>(3), ".");
+            rules_.push(name_.c_str(), "\\s+", rules_.skip(), ".");
+            rules_.push(name_.c_str(), "[-+*/=<>(){};,]",
+                static_cast<id_type>(4), ".");
+
+            for (std::size_t j_ = 0; j_ < states_; ++j_)
+            {
+                const std::string next_ = j_ == 0 ?
+                    "INITIAL" : "S" + std::to_string(j_);
+
+                rules_.push(name_.c_str(), ("@" + std::to_string(j_)).c_str(),
+                    static_cast<id_type>(5), next_.c_str());
+            }
+        }
+
+        timed_build<lexertl::basic_generator<decltype(rules_), sm_type>>
+            (label_, rules_, sm_);
+        sm_.minimise();
+    }
+
+    // C like tokens where most of the input is long string literals and
+    // block comments, whose bodies loop on almost every byte.
+    void build_literals(const char* label_, lexertl::state_machine& sm_)
+    {
+        lexertl::rules rules_;
+
+        rules_.push("\\\"([^\\\"\\\\]|\\\\.)*\\\"", 1);
+        rules_.push("\\/\\*([^*]|\\*+[^*/])*\\*+\\/", 2);
+        rules_.push("[a-z_][a-z0-9_]*", 3);
+        rules_.push("\\d+", 4);
+        rules_.push("\\s+", 5);
+        rules_.push("[-+*/=<>(){};,]", 6);
+        timed_build<lexertl::generator>(label_, rules_, sm_);
+        sm_.minimise();
+    }
+
+    std::string literals_input(const std::size_t size_)
+    {
+        std::mt19937 gen_(42);
+        std::string input_;
+
+        while (input_.size() < size_)
+        {
+            const std::size_t len_ = 64 + gen_() % 1024;
+
+            switch (gen_() % 3)
+            {
+            case 0:
+                input_ += '"';
+
+                for (std::size_t i_ = 0; i_ < len_; ++i_)
+                {
+                    input_ += i_ % 97 == 96 ? '\\' : 'a' + gen_() % 26;
+                }
+
+                input_ += "\" ";
+                break;
+            case 1:
+                input_ += "/*";
+
+                for (std::size_t i_ = 0; i_ < len_; ++i_)
+                {
+                    input_ += i_ % 61 == 60 ? '*' : ' ' + gen_() % 10;
+                }
+
+                input_ += "*/\n";
+                break;
+            default:
+                input_ += "x = y + 42;\n";
+                break;
+            }
+        }
+
+        return input_;
+    }
+
+    // Words in several scripts, numbers and punctuation.
+    template<typename sm_type, typename generator>
+    void build_utf8(const char* label_, sm_type& sm_)
+    {
+        lexertl::u32rules rules_;
+
+        rules_.push(U"\\p{L}+", 1);
+        rules_.push(U"\\d+", 2);
+        rules_.push(U"\\s+", 3);
+        rules_.push(U"[^\\p{L}\\d\\s]", 4);
+        timed_build<generator>(label_, rules_, sm_);
+        sm_.minimise();
+    }
+
+    std::string utf8_input(const std::size_t size_)
+    {
+        static const char* words_[] = { "alpha", "caf\xc3\xa9",
+            "\xce\xb1\xce\xbb\xcf\x86\xce\xb1", "1234",
+            "\xe4\xb8\xad\xe6\x96\x87", "\xe2\x82\xac", ",",
+            "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82" };
+        std::mt19937 gen_(42);
+        std::string input_;
+
+        while (input_.size() < size_)
+        {
+            input_ += words_[gen_() % (sizeof(words_) / sizeof(*words_))];
+            input_ += ' ';
+        }
+
+        return input_;
+    }
+
+    std::string multi_state_input(const std::size_t size_)
+    {
+        static const char* words_[] = { "alpha", "beta_2", "x", "1234",
+            "3.25", "(", ")", "=", "+", ";", "gamma_delta", "k0a", "k7b" };
+        std::mt19937 gen_(42);
+        std::string input_;
+
+        while (input_.size() < size_)
+        {
+            if (gen_() % 4 == 0)
+            {
+                input_ += '@';
+                input_ += std::to_string(gen_() % states_);
+            }
+            else
+            {
+                input_ += words_[gen_() % (sizeof(words_) / sizeof(*words_))];
+            }
+
+            input_ += ' ';
+        }
+
+        return input_;
+    }
+
+    // The synthetic corpora below are random sequences of representative
+    // fragments for the rule sets in bench_rules.hpp.
+    template<std::size_t size>
+    std::string fragments_input(const char* const (&fragments_)[size],
+        const std::size_t size_)
+    {
+        std::mt19937 gen_(42);
+        std::string input_;
+
+        while (input_.size() < size_)
+        {
+            input_ += fragments_[gen_() % size];
+        }
+
+        return input_;
+    }
+
+    std::string c_like_input(const std::size_t size_)
+    {
+        static const char* const fragments_[] = {
+            "static const char* greeting = \"hello, world\\n\";\n",
+            "for (int i = 0; i < 0x100; ++i)\n",
+            "{\n", "}\n",
+            "    total += values[i] * 3.25e-2;\n",
+            "    if (node->next != NULL && (flags & 4) == 0) return -1;\n",
+            "/* Walk the list until the sentinel is found. */\n",
+            "    // skip the escape character\n",
+            "    ch = '\\t';\n",
+            "unsigned long hash = 5381;\n",
+            "while ((c = *str++)) hash = ((hash << 5) + hash) + c;\n",
+            "typedef struct tree_node { struct tree_node* left; "
+                "struct tree_node* right; } tree_node;\n",
+            "    switch (state_) { case 1: break; default: goto done; }\n" };
+
+        return fragments_input(fragments_, size_);
+    }
+
+    std::string json_input(const std::size_t size_)
+    {
+        std::mt19937 gen_(42);
+        std::string input_ = "[\n";
+
+        while (input_.size() < size_)
+        {
+            const std::string id_ = std::to_string(gen_() % 1000000);
+
+            input_ += "  {\"id\": " + id_ + ", \"name\": \"user_" + id_ +
+                "\", \"active\": " + (gen_() % 2 ? "true" : "false") +
+                ", \"score\": -" + std::to_string(gen_() % 1000) + "." +
+                std::to_string(gen_() % 100) + "e2, \"tags\": [\"alpha\", "
+                "\"beta\\/gamma\"], \"address\": {\"city\": \"Z\\u00fcrich\","
+                " \"zip\": \"" + std::to_string(1000 + gen_() % 9000) +
+                "\"}, \"manager\": null},\n";
+        }
+
+        input_ += "  {}\n]\n";
+        return input_;
+    }
+
+    std::string log_input(const std::size_t size_)
+    {
+        static const char* const methods_[] = { "GET", "POST", "HEAD" };
+        static const char* const paths_[] = { "/index.html",
+            "/api/v1/users?page=2", "/static/css/site.css",
+            "/images/logo.png", "/login" };
+        static const char* const statuses_[] = { "200", "304", "404",
+            "500" };
+        std::mt19937 gen_(42);
+        std::string input_;
+
+        while (input_.size() < size_)
+        {
+            input_ += std::to_string(gen_() % 256) + '.' +
+                std::to_string(gen_() % 256) + '.' +
+                std::to_string(gen_() % 256) + '.' +
+                std::to_string(gen_() % 256) +
+                " - - [16/Oct/2026:13:" + std::to_string(10 + gen_() % 50) +
+                ':' + std::to_string(10 + gen_() % 50) + " +0000] \"" +
+                methods_[gen_() % 3] + ' ' + paths_[gen_() % 5] +
+                " HTTP/1.1\" " + statuses_[gen_() % 4] + ' ' +
+                std::to_string(gen_() % 100000) +
+                " \"https://example.com/\" \"Mozilla/5.0 (X11; Linux x86_64)"
+                " AppleWebKit/537.36 (KHTML, like Gecko)\"\n";
+        }
+
+        return input_;
+    }
+
+    std::string sql_input(const std::size_t size_)
+    {
+        static const char* const fragments_[] = {
+            "SELECT u.id, u.name, COUNT(*) AS total FROM users u INNER JOIN "
+                "orders o ON u.id = o.user_id WHERE u.active = TRUE AND "
+                "o.created BETWEEN '2026-01-01' AND '2026-12-31' GROUP BY "
+                "u.id, u.name HAVING COUNT(*) > 5 ORDER BY total DESC "
+                "LIMIT 10;\n",
+            "insert into audit_log (user_id, action, note) values "
+                "(42, 'login', 'it''s fine');\n",
+            "Update accounts Set balance = balance - 125.50 Where id = 7 "
+                "And balance >= 125.50;\n",
+            "-- nightly clean up\n",
+            "DELETE FROM sessions WHERE expires < CAST('2026-10-16' AS "
+                "DATE) OR user_id IS NULL;\n",
+            "create table if_missing (id integer primary key, name "
+                "varchar(64) not null unique, created timestamp default "
+                "null);\n",
+            "select distinct name from products where price not in "
+                "(select max(price) from products) union all select "
+                "name from archive;\n",
+            "BEGIN TRANSACTION; UPDATE stock SET qty = qty - 1 WHERE sku = "
+                "'A-100'; COMMIT;\n" };
+
+        return fragments_input(fragments_, size_);
+    }
+
+    template<typename sm_type>
+    std::size_t tokenise(const sm_type& sm_, const std::string& input_)
+    {
+        lexertl::match_results<const char*, typename sm_type::id_type>
+            results_(input_.c_str(), input_.c_str() + input_.size());
+        std::size_t count_ = 0;
+
+        do
+        {
+            lexertl::lookup(sm_, results_);
+            ++count_;
+        } while (results_.id != 0);
+
+        return count_;
+    }
+
+    // Counts the end of input token too, like tokenise().
+    template<typename sm_type>
+    std::size_t tokenise_batch(const sm_type& sm_, const std::string& input_)
+    {
+        lexertl::basic_token_buffer<const char*, typename sm_type::id_type>
+            buffer_(4096);
+        std::size_t count_ = 1;
+        bool more_ = true;
+
+        while (more_)
+        {
+            more_ = lexertl::tokenise_batch(sm_, input_.c_str(),
+                input_.c_str() + input_.size(), buffer_);
+            count_ += buffer_.size;
+        }
+
+        return count_;
+    }
+
+    // Splits the input into four streams (at spaces) and tokenises them
+    // in lock-step. Counts one end of input token, like tokenise().
+    template<typename sm_type>
+    std::size_t tokenise_interleaved(const sm_type& sm_,
+        const std::string& input_)
+    {
+        const std::size_t streams_ = 4;
+        std::array<lexertl::match_results<const char*,
+            typename sm_type::id_type>, streams_> results_;
+        const char* first_ = input_.c_str();
+        const char* const last_ = first_ + input_.size();
+        std::size_t count_ = 1;
+        std::size_t active_ = streams_;
+
+        for (std::size_t i_ = 0; i_ < streams_; ++i_)
+        {
+            const char* second_ = i_ + 1 == streams_ ? last_ :
+                std::find(first_ + input_.size() / streams_, last_, ' ');
+
+            results_[i_].reset(first_, second_);
+            first_ = second_;
+        }
+
+        while (active_)
+        {
+            lexertl::lookup(sm_, results_);
+            active_ = 0;
+
+            for (const auto& res_ : results_)
+            {
+                if (res_.id != 0)
+                {
+                    ++active_;
+                    ++count_;
+                }
+            }
+        }
+
+        return count_;
+    }
+
+    // Uses every hardware thread. Counts one end of input token, like
+    // tokenise().
+    template<typename sm_type>
+    std::size_t tokenise_parallel(const sm_type& sm_,
+        const std::string& input_)
+    {
+        lexertl::basic_token_buffer<const char*, typename sm_type::id_type>
+            buffer_(0);
+
+        lexertl::tokenise_parallel(sm_, input_.c_str(),
+            input_.c_str() + input_.size(), buffer_);
+        return buffer_.size + 1;
+    }
+
+    // Decodes UTF-8 to code points for a char32_t state machine.
+    std::size_t tokenise_utf8_in(const lexertl::u32state_machine& sm_,
+        const std::string& input_)
+    {
+        using iter_type =
+            lexertl::basic_utf8_in_iterator<const char*, char32_t>;
+        const char* first_ = input_.c_str();
+        const char* last_ = first_ + input_.size();
+        lexertl::match_results<iter_type, uint16_t>
+            results_(iter_type(first_, last_), iter_type(last_, last_));
+        std::size_t count_ = 0;
+
+        do
+        {
+            lexertl::lookup(sm_, results_);
+            ++count_;
+        } while (results_.id != 0);
+
+        return count_;
+    }
+
+    // Counts the end of input token too, like tokenise().
+    template<typename sm_type>
+    std::size_t tokenise_iterator(const sm_type& sm_,
+        const std::string& input_)
+    {
+        lexertl::iterator<const char*, sm_type, lexertl::cmatch>
+            iter_(input_.c_str(), input_.c_str() + input_.size(), sm_);
+        const lexertl::iterator<const char*, sm_type, lexertl::cmatch> end_;
+        std::size_t count_ = 1;
+
+        for (; iter_ != end_; ++iter_)
+        {
+            ++count_;
+        }
+
+        return count_;
+    }
+
+    // Replaces every token with a single \x01 and counts those in the
+    // output, plus one for the end of input token.
+    std::size_t tokenise_replace(const lexertl::state_machine& sm_,
+        const std::string& input_)
+    {
+        std::string output_;
+
+        output_.reserve(input_.size());
+        lexertl::replace(std::back_inserter(output_), input_.c_str(),
+            input_.c_str() + input_.size(), sm_, "\x01");
+        return std::count(output_.cbegin(), output_.cend(), '\x01') + 1;
+    }
+
+    // Runs lookup_, one of the functions in lexertl_bench_generated.hpp,
+    // in place of lookup(). sm_ is only there to match the other
+    // tokenise functions.
+    template<void (*lookup_)(lexertl::cmatch&)>
+    std::size_t tokenise_generated(const lexertl::state_machine&,
+        const std::string& input_)
+    {
+        lexertl::cmatch results_(input_.c_str(),
+            input_.c_str() + input_.size());
+        std::size_t count_ = 0;
+
+        do
+        {
+            lookup_(results_);
+            ++count_;
+        } while (results_.id != 0);
+
+        return count_;
+    }
+
+    // Records which states lookup() uses on the first size_ bytes of
+    // input_.
+    template<typename sm_type>
+    lexertl::basic_profile<typename sm_type::id_type> profile(
+        const sm_type& sm_, const std::string& input_, const std::size_t size_)
+    {
+        using id_type = typename sm_type::id_type;
+        lexertl::basic_profile<id_type> profile_;
+        lexertl::match_results<const char*, id_type, +lexertl::feature_bit::
+            bol | +lexertl::feature_bit::eol | +lexertl::feature_bit::skip |
+            +lexertl::feature_bit::again | +lexertl::feature_bit::multi_state |
+            +lexertl::feature_bit::advance | +lexertl::feature_bit::profile>
+            results_(input_.c_str(), input_.c_str() +
+                std::min(size_, input_.size()));
+
+        results_.profile = &profile_;
+
+        do
+        {
+            lexertl::lookup(sm_, results_);
+        } while (results_.id != 0);
+
+        return profile_;
+    }
+
+    // Best of several runs, reported in MB/s and tokens/s.
+    template<typename sm_type>
+    void run(const std::string& name_, const sm_type& sm_,
+        const std::string& input_,
+        std::size_t (*tokenise_)(const sm_type&, const std::string&) =
+        tokenise<sm_type>)
+    {
+        using clock = std::chrono::steady_clock;
+        const int runs_ = 7;
+        double best_ = 0;
+        std::size_t tokens_ = 0;
+        throughput result_;
+
+        for (int i_ = 0; i_ < runs_; ++i_)
+        {
+            const auto start_ = clock::now();
+
+            tokens_ = tokenise_(sm_, input_);
+
+            const std::chrono::duration<double> secs_ = clock::now() - start_;
+
+            best_ = i_ == 0 ? secs_.count() : std::min(best_, secs_.count());
+        }
+
+        result_._name = name_;
+        result_._mb_per_s = input_.size() / best_ / 1e6;
+        result_._tokens_per_s = tokens_ / best_;
+        result_._tokens = tokens_;
+        std::printf("%-44s %10.1f MB/s %12.0f tokens/s %10zu tokens\n",
+            name_.c_str(), result_._mb_per_s, result_._tokens_per_s, tokens_);
+        throughput_.push_back(result_);
+    }
+
+    // Runs one of the rule sets from bench_rules.hpp through lookup() on
+    // both kinds of state machine, the iterator, replace() and the
+    // table_based_cpp code generated from it (with and without pointers).
+    void run_rule_set(const std::string& name_,
+        void (*rules_fn_)(lexertl::rules&), const std::string& input_,
+        std::size_t (*generated_)(const lexertl::state_machine&,
+            const std::string&),
+        std::size_t (*generated_ptr_)(const lexertl::state_machine&,
+            const std::string&))
+    {
+        lexertl::rules rules_;
+        lexertl::state_machine sm_;
+
+        rules_fn_(rules_);
+        timed_build<lexertl::generator>(name_.c_str(), rules_, sm_);
+        sm_.minimise();
+
+        const lexertl::flat_state_machine flat_(sm_);
+
+        run(name_ + "/state_machine", sm_, input_);
+        run(name_ + "/flat_state_machine", flat_, input_);
+        run(name_ + "/iterator", sm_, input_,
+            tokenise_iterator<lexertl::state_machine>);
+        run(name_ + "/replace", sm_, input_, tokenise_replace);
+        run(name_ + "/table_based_cpp", sm_, input_, generated_);
+        run(name_ + "/table_based_cpp_pointers", sm_, input_, generated_ptr_);
+    }
+
+    // The names are all plain ASCII, so need no escaping.
+    bool write_json(const char* path_)
+    {
+        std::FILE* file_ = std::fopen(path_, "w");
+
+        if (!file_)
+        {
+            return false;
+        }
+
+        std::fprintf(file_, "{\n  \"input_size\": %zu,\n"
+            "  \"throughput\": [", input_size_);
+
+        for (std::size_t i_ = 0; i_ < throughput_.size(); ++i_)
+        {
+            const throughput& result_ = throughput_[i_];
+
+            std::fprintf(file_, "%s\n    {\"name\": \"%s\", "
+                "\"mb_per_s\": %.1f, \"tokens_per_s\": %.0f, "
+                "\"tokens\": %zu}", i_ == 0 ? "" : ",",
+                result_._name.c_str(), result_._mb_per_s,
+                result_._tokens_per_s, result_._tokens);
+        }
+
+        std::fprintf(file_, "\n  ],\n  \"build\": [");
+
+        for (std::size_t i_ = 0; i_ < build_time_.size(); ++i_)
+        {
+            std::fprintf(file_, "%s\n    {\"name\": \"%s\", \"ms\": %.3f}",
+                i_ == 0 ? "" : ",", build_time_[i_]._name.c_str(),
+                build_time_[i_]._ms);
+        }
+
+        std::fprintf(file_, "\n  ]\n}\n");
+        return std::fclose(file_) == 0;
+    }
+}
+
+int main(int argc_, char* argv_[])
+{
+    const char* json_ = nullptr;
+
+    for (int i_ = 1; i_ < argc_; ++i_)
+    {
+        if (std::strcmp(argv_[i_], "--json") == 0 && i_ + 1 < argc_)
+        {
+            json_ = argv_[++i_];
+        }
+        else if (std::strcmp(argv_[i_], "--size") == 0 && i_ + 1 < argc_)
+        {
+            input_size_ =
+                std::strtoul(argv_[++i_], nullptr, 10) * 1024 * 1024;
+        }
+        else
+        {
+            std::fprintf(stderr,
+                "Usage: lexertl_bench [--size <MiB>] [--json <file>]\n");
+            return 1;
+        }
+    }
+
+    run_rule_set("c_like", bench::c_like_rules, c_like_input(input_size_),
+        tokenise_generated<bench::lookup_c_like>,
+        tokenise_generated<bench::lookup_c_like_ptr>);
+    run_rule_set("json", bench::json_rules, json_input(input_size_),
+        tokenise_generated<bench::lookup_json>,
+        tokenise_generated<bench::lookup_json_ptr>);
+    run_rule_set("log", bench::log_rules, log_input(input_size_),
+        tokenise_generated<bench::lookup_log>,
+        tokenise_generated<bench::lookup_log_ptr>);
+    run_rule_set("sql", bench::sql_rules, sql_input(input_size_),
+        tokenise_generated<bench::lookup_sql>,
+        tokenise_generated<bench::lookup_sql_ptr>);
+
+    const std::string input_ = multi_state_input(input_size_);
+    lexertl::state_machine sm_;
+    lexertl::basic_state_machine<char, uint32_t> sm32_;
+
+    build_multi_state("multi_state", sm_);
+    build_multi_state("multi_state_u32", sm32_);
+
+    lexertl::state_machine renumbered_(sm_);
+    lexertl::state_machine profiled_(sm_);
+    const lexertl::profile profile_ = profile(sm_, input_, 1024 * 1024);
+
+    renumbered_.renumber();
+    profiled_.renumber(profile_);
+
+    const lexertl::flat_state_machine flat_(sm_);
+    const lexertl::flat_state_machine flat_renumbered_(renumbered_);
+    const lexertl::flat_state_machine flat_profiled_(profiled_, profile_);
+    const lexertl::flat_state_machine flat_rows_(sm_, false);
+    const lexertl::basic_flat_state_machine<char, uint32_t> flat32_(sm32_);
+
+    run("multi_state/state_machine", sm_, input_);
+    run("multi_state/flat_state_machine", flat_, input_);
+    run("multi_state/state_machine_renumbered", renumbered_, input_);
+    run("multi_state/flat_state_machine_renumbered", flat_renumbered_,
+        input_);
+    run("multi_state/flat_state_machine_profiled", flat_profiled_, input_);
+    run("multi_state/flat_state_machine_rows", flat_rows_, input_);
+    run("multi_state/flat_state_machine_batch", flat_, input_,
+        tokenise_batch<lexertl::flat_state_machine>);
+    run("multi_state/flat_state_machine_interleaved", flat_, input_,
+        tokenise_interleaved<lexertl::flat_state_machine>);
+    run("multi_state/flat_state_machine_parallel", flat_, input_,
+        tokenise_parallel<lexertl::flat_state_machine>);
+    run("multi_state/state_machine_u32", sm32_, input_);
+    run("multi_state/flat_state_machine_u32", flat32_, input_);
+
+    const std::string literals_ = literals_input(input_size_);
+    lexertl::state_machine lit_sm_;
+
+    build_literals("literals", lit_sm_);
+
+    const lexertl::flat_state_machine lit_flat_(lit_sm_);
+
+    run("literals/state_machine", lit_sm_, literals_);
+    run("literals/flat_state_machine", lit_flat_, literals_);
+    run("literals/flat_state_machine_parallel", lit_flat_, literals_,
+        tokenise_parallel<lexertl::flat_state_machine>);
+
+    const std::string utf8_ = utf8_input(input_size_);
+    lexertl::u32state_machine utf8_u32_;
+    lexertl::u32state_machine utf8_paged_;
+    lexertl::state_machine utf8_sm_;
+
+    build_utf8<lexertl::u32state_machine, lexertl::u32generator>
+        ("utf8_u32", utf8_u32_);
+    build_utf8<lexertl::u32state_machine, lexertl::u32paged_generator>
+        ("utf8_u32paged", utf8_paged_);
+    build_utf8<lexertl::state_machine, lexertl::utf8_generator>
+        ("utf8", utf8_sm_);
+
+    const lexertl::flat_state_machine utf8_flat_(utf8_sm_);
+
+    run("utf8/u32state_machine_utf8_in_iterator", utf8_u32_, utf8_,
+        tokenise_utf8_in);
+    run("utf8/u32paged_state_machine_utf8_in_iterator", utf8_paged_, utf8_,
+        tokenise_utf8_in);
+    run("utf8/state_machine", utf8_sm_, utf8_);
+    run("utf8/flat_state_machine", utf8_flat_, utf8_);
+
+    if (json_ && !write_json(json_))
+    {
+        std::fprintf(stderr, "Unable to write %s\n", json_);
+        return 1;
+    }
+
+    return 0;
+}
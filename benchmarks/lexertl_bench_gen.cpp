@@ -0,0 +1,60 @@
+// lexertl_bench_gen.cpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Writes table_based_cpp code for the benchmark rule sets to the file
+// named on the command line, for lexertl_bench to include.
+#include "bench_rules.hpp"
+
+#include <lexertl/generate_cpp.hpp>
+#include <lexertl/generator.hpp>
+#include <lexertl/state_machine.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    void generate(const std::string& name_, void (*rules_fn_)(lexertl::rules&),
+        std::ostream& os_)
+    {
+        lexertl::rules rules_;
+        lexertl::state_machine sm_;
+
+        rules_fn_(rules_);
+        lexertl::generator::build(rules_, sm_);
+        sm_.minimise();
+        lexertl::table_based_cpp::generate("lookup_" + name_, sm_, false,
+            os_);
+        os_ << '\n';
+        lexertl::table_based_cpp::generate("lookup_" + name_ + "_ptr", sm_,
+            true, os_);
+        os_ << '\n';
+    }
+}
+
+int main(int argc_, char* argv_[])
+{
+    if (argc_ != 2)
+    {
+        std::cerr << "Usage: lexertl_bench_gen <output file>\n";
+        return 1;
+    }
+
+    std::ofstream os_(argv_[1]);
+
+    os_ << "// Generated by lexertl_bench_gen. Do not edit.\n";
+    os_ << "#ifndef LEXERTL_BENCH_GENERATED_HPP\n";
+    os_ << "#define LEXERTL_BENCH_GENERATED_HPP\n\n";
+    os_ << "#include <lexertl/match_results.hpp>\n\n";
+    os_ << "namespace bench\n{\n";
+    generate("c_like", bench::c_like_rules, os_);
+    generate("json", bench::json_rules, os_);
+    generate("log", bench::log_rules, os_);
+    generate("sql", bench::sql_rules, os_);
+    os_ << "}\n\n#endif\n";
+    return os_ ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// accelerate.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_ACCELERATE_HPP
+#define LEXERTL_ACCELERATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEXERTL_ACCELERATE_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace lexertl
+{
+    namespace detail
+    {
+        // A DFA state that transitions back to itself on every byte except
+        // at most max_exit "exit" bytes. A run of such a state can be
+        // skipped by searching for the next exit byte instead of walking
+        // the DFA one character at a time (string literal and comment
+        // bodies are typical examples). Each exit byte costs another
+        // compare per 16 bytes of input, but even 16 of them skip a run
+        // several times faster than walking the DFA.
+        struct accel_state
+        {
+            enum { max_exit = 16, none = 0xff };
+
+            unsigned char _size = none;
+            unsigned char _exit[max_exit] = {};
+
+            bool empty() const
+            {
+                return _size == none;
+            }
+
+            // Returns the first exit byte in [first_, last_) or last_.
+            const unsigned char* find(const unsigned char* first_,
+                const unsigned char* last_) const
+            {
+                if (_size == 1)
+                {
+                    const void* ptr_ = std::memchr(first_, _exit[0],
+                        last_ - first_);
+
+                    return ptr_ ?
+                        static_cast<const unsigned char*>(ptr_) : last_;
+                }
+
+#ifdef LEXERTL_ACCELERATE_SSE2
+                __m128i exit_[max_exit];
+
+                for (std::size_t i_ = 0; i_ < _size; ++i_)
+                {
+                    exit_[i_] = _mm_set1_epi8(static_cast<char>(_exit[i_]));
+                }
+
+                for (; last_ - first_ >= 16; first_ += 16)
+                {
+                    const __m128i block_ = _mm_loadu_si128
+                        (reinterpret_cast<const __m128i*>(first_));
+                    __m128i match_ = _mm_setzero_si128();
+
+                    for (std::size_t i_ = 0; i_ < _size; ++i_)
+                    {
+                        match_ = _mm_or_si128(match_,
+                            _mm_cmpeq_epi8(block_, exit_[i_]));
+                    }
+
+                    const unsigned mask_ =
+                        static_cast<unsigned>(_mm_movemask_epi8(match_));
+
+                    if (mask_)
+                    {
+                        return first_ + lowest_bit(mask_);
+                    }
+                }
+#endif
+
+                // Membership mask of the exit bytes
+                uint32_t set_[8] = {};
+
+                for (std::size_t i_ = 0; i_ < _size; ++i_)
+                {
+                    set_[_exit[i_] >> 5] |= 1u << (_exit[i_] & 31);
+                }
+
+                for (; first_ != last_; ++first_)
+                {
+                    if (set_[*first_ >> 5] & (1u << (*first_ & 31)))
+                    {
+                        return first_;
+                    }
+                }
+
+                return last_;
+            }
+
+            template<typename char_type>
+            const char_type* find(const char_type* first_,
+                const char_type* last_) const
+            {
+                static_assert(sizeof(char_type) == 1,
+                    "accel_state only scans single byte input");
+
+                const unsigned char* begin_ =
+                    reinterpret_cast<const unsigned char*>(first_);
+
+                return first_ + (find(begin_,
+                    reinterpret_cast<const unsigned char*>(last_)) - begin_);
+            }
+
+        private:
+#ifdef LEXERTL_ACCELERATE_SSE2
+            static std::size_t lowest_bit(const unsigned mask_)
+            {
+#ifdef _MSC_VER
+                unsigned long idx_ = 0;
+
+                _BitScanForward(&idx_, mask_);
+                return idx_;
+#else
+                return __builtin_ctz(mask_);
+#endif
+            }
+#endif
+        };
+    }
+}
+
+#endif
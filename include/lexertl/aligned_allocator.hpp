@@ -0,0 +1,76 @@
+// aligned_allocator.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_ALIGNED_ALLOCATOR_HPP
+#define LEXERTL_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace lexertl
+{
+    namespace detail
+    {
+        // Size of a cache line on all mainstream CPUs.
+        enum { cache_line = 64 };
+
+        // Allocator returning storage that starts on a cache line boundary.
+        // C++14 has no over-aligned operator new, so we over-allocate and
+        // keep the pointer that operator new returned just before the
+        // aligned block.
+        template<typename T>
+        struct cache_aligned_allocator
+        {
+            using value_type = T;
+
+            cache_aligned_allocator() = default;
+
+            template<typename U>
+            cache_aligned_allocator(const cache_aligned_allocator<U>&) noexcept
+            {
+            }
+
+            T* allocate(const std::size_t size_)
+            {
+                if (size_ > (std::numeric_limits<std::size_t>::max() -
+                    cache_line - sizeof(void*)) / sizeof(T))
+                {
+                    throw std::bad_alloc();
+                }
+
+                void* raw_ = ::operator new(size_ * sizeof(T) + cache_line +
+                    sizeof(void*));
+                std::uintptr_t addr_ =
+                    reinterpret_cast<std::uintptr_t>(raw_) + sizeof(void*);
+
+                addr_ = (addr_ + cache_line - 1) &
+                    ~static_cast<std::uintptr_t>(cache_line - 1);
+                reinterpret_cast<void**>(addr_)[-1] = raw_;
+                return reinterpret_cast<T*>(addr_);
+            }
+
+            void deallocate(T* ptr_, const std::size_t) noexcept
+            {
+                ::operator delete(reinterpret_cast<void**>(ptr_)[-1]);
+            }
+
+            friend bool operator ==(const cache_aligned_allocator&,
+                const cache_aligned_allocator&)
+            {
+                return true;
+            }
+
+            friend bool operator !=(const cache_aligned_allocator&,
+                const cache_aligned_allocator&)
+            {
+                return false;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,198 @@
+// arena.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_ARENA_HPP
+#define LEXERTL_ARENA_HPP
+
+#include "observer_ptr.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lexertl
+{
+    namespace detail
+    {
+        // Monotonic buffer: objects are carved out of large blocks and are
+        // only destroyed all together, by clear() or the destructor.
+        // clear() keeps the blocks so that they can be reused.
+        class arena
+        {
+        public:
+            arena() = default;
+            arena(const arena&) = delete;
+            arena& operator =(const arena&) = delete;
+
+            ~arena()
+            {
+                clear();
+
+                for (const auto& block_ : _blocks)
+                {
+                    ::operator delete(block_.first);
+                }
+            }
+
+            template<typename type, typename... arg_types>
+            observer_ptr<type> create(arg_types&&... args_)
+            {
+                static_assert(alignof(type) <= alignof(std::max_align_t),
+                    "type is over aligned.");
+
+                void* ptr_ = allocate(sizeof(type), alignof(type));
+
+                if (std::is_trivially_destructible<type>::value)
+                {
+                    return new (ptr_) type(std::forward<arg_types>(args_)...);
+                }
+
+                // Make room first so that recording the destructor cannot
+                // throw once the object exists.
+                _destructors.emplace_back(ptr_, nullptr);
+
+                try
+                {
+                    new (ptr_) type(std::forward<arg_types>(args_)...);
+                }
+                catch (...)
+                {
+                    _destructors.pop_back();
+                    throw;
+                }
+
+                _destructors.back().second = &destroy<type>;
+                return static_cast<type*>(ptr_);
+            }
+
+            // Destroys every object, most recent first.
+            void clear() noexcept
+            {
+                for (auto iter_ = _destructors.rbegin(),
+                    end_ = _destructors.rend(); iter_ != end_; ++iter_)
+                {
+                    iter_->second(iter_->first);
+                }
+
+                _destructors.clear();
+                _block = 0;
+                _used = 0;
+            }
+
+        private:
+            enum
+            {
+                first_block = 4096,
+                max_block = 1024 * 1024
+            };
+
+            // (memory, size)
+            std::vector<std::pair<char*, std::size_t>> _blocks;
+            // The block being allocated from and the bytes used in it
+            std::size_t _block = 0;
+            std::size_t _used = 0;
+            std::vector<std::pair<void*, void (*)(void*)>> _destructors;
+
+            template<typename type>
+            static void destroy(void* ptr_)
+            {
+                static_cast<type*>(ptr_)->~type();
+            }
+
+            // Blocks come from ::operator new, so are aligned for any
+            // align_ up to alignof(std::max_align_t).
+            void* allocate(const std::size_t size_, const std::size_t align_)
+            {
+                for (;;)
+                {
+                    if (_block < _blocks.size())
+                    {
+                        const auto& block_ = _blocks[_block];
+                        const std::size_t offset_ =
+                            (_used + align_ - 1) & ~(align_ - 1);
+
+                        if (offset_ + size_ <= block_.second)
+                        {
+                            _used = offset_ + size_;
+                            return block_.first + offset_;
+                        }
+
+                        ++_block;
+                        _used = 0;
+                        continue;
+                    }
+
+                    const std::size_t bytes_ = std::max(size_, _blocks.empty() ?
+                        static_cast<std::size_t>(first_block) :
+                        std::min(_blocks.back().second * 2,
+                            static_cast<std::size_t>(max_block)));
+
+                    _blocks.emplace_back(nullptr, 0);
+                    _blocks.back().first =
+                        static_cast<char*>(::operator new(bytes_));
+                    _blocks.back().second = bytes_;
+                    _block = _blocks.size() - 1;
+                    _used = 0;
+                }
+            }
+        };
+
+        // Pointers to objects derived from base_type, in the order they
+        // were created, all owned by an arena.
+        template<typename base_type>
+        class arena_ptr_vector
+        {
+        public:
+            template<typename type, typename... arg_types>
+            observer_ptr<type> create(arg_types&&... args_)
+            {
+                _ptrs.push_back(nullptr);
+
+                try
+                {
+                    observer_ptr<type> ptr_ = _arena.template create<type>
+                        (std::forward<arg_types>(args_)...);
+
+                    _ptrs.back() = ptr_;
+                    return ptr_;
+                }
+                catch (...)
+                {
+                    _ptrs.pop_back();
+                    throw;
+                }
+            }
+
+            bool empty() const
+            {
+                return _ptrs.empty();
+            }
+
+            std::size_t size() const
+            {
+                return _ptrs.size();
+            }
+
+            observer_ptr<base_type> operator [](const std::size_t index_) const
+            {
+                return _ptrs[index_];
+            }
+
+            observer_ptr<base_type> back() const
+            {
+                return _ptrs.back();
+            }
+
+        private:
+            arena _arena;
+            std::vector<observer_ptr<base_type>> _ptrs;
+        };
+    }
+}
+
+#endif
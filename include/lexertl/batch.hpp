@@ -0,0 +1,131 @@
+// batch.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_BATCH_HPP
+#define LEXERTL_BATCH_HPP
+
+#include "lookup.hpp"
+#include "match_results.hpp"
+#include "runtime_error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace lexertl
+{
+    // Tokens stored column by column (struct of arrays) by
+    // tokenise_batch(). start holds the offset of each token from the
+    // start of the input and length its size. The columns are allocated
+    // once, up front; size is the number of tokens currently held.
+    template<typename iter, typename id_t = uint16_t,
+        std::size_t flags = +feature_bit::bol | +feature_bit::eol |
+        +feature_bit::skip | +feature_bit::again | +feature_bit::multi_state |
+        +feature_bit::advance>
+    struct basic_token_buffer
+    {
+        using id_type = id_t;
+        using iter_type = iter;
+        using results = match_results<iter_type, id_type, flags>;
+        using id_vector = std::vector<id_type>;
+        using size_vector = std::vector<std::size_t>;
+
+        id_vector id;
+        id_vector user_id;
+        size_vector start;
+        size_vector length;
+        std::size_t size = 0;
+        // Where the next call to tokenise_batch() carries on from
+        results match;
+        bool started = false;
+
+        explicit basic_token_buffer(const std::size_t capacity_) :
+            id(capacity_),
+            user_id(capacity_),
+            start(capacity_),
+            length(capacity_)
+        {
+        }
+
+        std::size_t capacity() const
+        {
+            return id.size();
+        }
+
+        // Forget any input in progress so that the next call to
+        // tokenise_batch() starts again.
+        void clear()
+        {
+            size = 0;
+            match = results();
+            started = false;
+        }
+    };
+
+    // Fills buffer_ with as many tokens of [first_, last_) as fit,
+    // carrying on from where the previous call left off. Pass the same
+    // input on every call. Returns false once the whole input has been
+    // consumed; the end of input token itself is not stored. Throws
+    // runtime_error if buffer_ has no capacity, as no progress could be
+    // made.
+    template<typename sm_type, typename iter_type, std::size_t flags>
+    bool tokenise_batch(const sm_type& sm_, const iter_type& first_,
+        const iter_type& last_, basic_token_buffer<iter_type,
+        typename sm_type::id_type, flags>& buffer_)
+    {
+        static_assert(std::is_base_of<std::random_access_iterator_tag,
+            typename std::iterator_traits<iter_type>::iterator_category>::
+            value, "tokenise_batch() needs random access iterators");
+
+        using id_type = typename sm_type::id_type;
+        auto& results_ = buffer_.match;
+        const std::size_t capacity_ = buffer_.capacity();
+        id_type* id_ = buffer_.id.data();
+        id_type* user_id_ = buffer_.user_id.data();
+        std::size_t* start_ = buffer_.start.data();
+        std::size_t* length_ = buffer_.length.data();
+        std::size_t size_ = 0;
+
+        if (capacity_ == 0)
+        {
+            throw runtime_error("tokenise_batch() needs a token_buffer "
+                "with a capacity of at least 1.");
+        }
+
+        if (!buffer_.started)
+        {
+            results_.reset(first_, last_);
+            buffer_.started = true;
+        }
+
+        for (; size_ < capacity_; ++size_)
+        {
+            lookup(sm_, results_);
+
+            if (results_.id == sm_.eoi() && results_.first == last_)
+            {
+                buffer_.size = size_;
+                return false;
+            }
+
+            id_[size_] = results_.id;
+            user_id_[size_] = results_.user_id;
+            start_[size_] = static_cast<std::size_t>(results_.first - first_);
+            length_[size_] =
+                static_cast<std::size_t>(results_.second - results_.first);
+        }
+
+        buffer_.size = size_;
+        return true;
+    }
+
+    using ctoken_buffer = basic_token_buffer<const char*>;
+    using wctoken_buffer = basic_token_buffer<const wchar_t*>;
+    using u32ctoken_buffer = basic_token_buffer<const char32_t*>;
+}
+
+#endif
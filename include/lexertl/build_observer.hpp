@@ -0,0 +1,176 @@
+// build_observer.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_BUILD_OBSERVER_HPP
+#define LEXERTL_BUILD_OBSERVER_HPP
+
+#include "enum_operator.hpp"
+#include "enums.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lexertl
+{
+    // Pass one of these to basic_generator::build() and
+    // basic_state_machine::minimise() to find out where the time goes
+    // when building a state machine. Every function does nothing by
+    // default, so override only those of interest. dfa_ is the index of
+    // the lexer state being built; lexer states are built in order.
+    template<typename id_ty = uint16_t>
+    class basic_build_observer
+    {
+    public:
+        using id_type = id_ty;
+        using duration = std::chrono::steady_clock::duration;
+
+        virtual ~basic_build_observer() = default;
+
+        // Called as each phase of building lexer state dfa_ finishes.
+        virtual void phase(const id_type /*dfa_*/,
+            const build_phase /*phase_*/, const duration& /*elapsed_*/)
+        {
+        }
+
+        // The regex syntax trees of every lexer state built so far hold
+        // nodes_ nodes. They are only freed once build() finishes, so
+        // the last call gives the peak.
+        virtual void nodes(const id_type /*dfa_*/,
+            const std::size_t /*nodes_*/)
+        {
+        }
+
+        // The charsets_ distinct charsets used by the rules of lexer
+        // state dfa_ were partitioned into partitions_ disjoint sets, one
+        // per column of the DFA.
+        virtual void charsets(const id_type /*dfa_*/,
+            const std::size_t /*charsets_*/, const std::size_t /*partitions_*/)
+        {
+        }
+
+        // Called as each DFA state of lexer state dfa_ gets its
+        // transitions: done_ of the states_ found so far are complete.
+        // minimise() calls it once per lexer state with the final count.
+        virtual void states(const id_type /*dfa_*/,
+            const std::size_t /*done_*/, const std::size_t /*states_*/)
+        {
+        }
+    };
+
+    // Records everything reported to a basic_build_observer, per lexer
+    // state.
+    template<typename id_ty = uint16_t>
+    class basic_build_stats : public basic_build_observer<id_ty>
+    {
+    public:
+        using id_type = id_ty;
+        using duration = typename basic_build_observer<id_type>::duration;
+
+        struct dfa_stats
+        {
+            // Indexed by build_phase
+            std::array<duration, +build_phase::minimise + 1> _phases {};
+            std::size_t _nodes = 0;
+            std::size_t _charsets = 0;
+            std::size_t _partitions = 0;
+            // DFA states after subset construction and after minimise()
+            std::size_t _states = 0;
+            std::size_t _minimised = 0;
+        };
+
+        std::vector<dfa_stats> _dfas;
+
+        void clear()
+        {
+            _dfas.clear();
+            _minimise = false;
+        }
+
+        duration total() const
+        {
+            duration total_ {};
+
+            for (const auto& dfa_ : _dfas)
+            {
+                for (const auto& elapsed_ : dfa_._phases)
+                {
+                    total_ += elapsed_;
+                }
+            }
+
+            return total_;
+        }
+
+        std::size_t peak_nodes() const
+        {
+            std::size_t nodes_ = 0;
+
+            for (const auto& dfa_ : _dfas)
+            {
+                nodes_ = std::max(nodes_, dfa_._nodes);
+            }
+
+            return nodes_;
+        }
+
+        void phase(const id_type dfa_, const build_phase phase_,
+            const duration& elapsed_) override
+        {
+            at(dfa_)._phases[*phase_] += elapsed_;
+            _minimise = phase_ == build_phase::minimise;
+        }
+
+        void nodes(const id_type dfa_, const std::size_t nodes_) override
+        {
+            at(dfa_)._nodes = nodes_;
+        }
+
+        void charsets(const id_type dfa_, const std::size_t charsets_,
+            const std::size_t partitions_) override
+        {
+            dfa_stats& stats_ = at(dfa_);
+
+            stats_._charsets = charsets_;
+            stats_._partitions = partitions_;
+        }
+
+        void states(const id_type dfa_, const std::size_t /*done_*/,
+            const std::size_t states_) override
+        {
+            if (_minimise)
+            {
+                at(dfa_)._minimised = states_;
+            }
+            else
+            {
+                at(dfa_)._states = states_;
+            }
+        }
+
+    private:
+        // minimise() reports its phase before its state counts, whereas
+        // build() reports states during (so before the end of) closure.
+        bool _minimise = false;
+
+        dfa_stats& at(const id_type dfa_)
+        {
+            if (dfa_ >= _dfas.size())
+            {
+                _dfas.resize(static_cast<std::size_t>(dfa_) + 1);
+            }
+
+            return _dfas[dfa_];
+        }
+    };
+
+    using build_observer = basic_build_observer<>;
+    using build_stats = basic_build_stats<>;
+}
+
+#endif
@@ -7,6 +7,7 @@
 #define LEXERTL_DEBUG_HPP
 
 #include "parser/tokeniser/re_token.hpp"
+#include "profile.hpp"
 #include "rules.hpp"
 #include "sm_to_csm.hpp"
 #include "state_machine.hpp"
@@ -20,6 +21,8 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace lexertl
 {
@@ -191,6 +194,69 @@ namespace lexertl
             }
         }
 
+        // Characters examined and consumed, the rules from most to least
+        // matched and the number of lookups started in each lexer state
+        // followed by how often each of its states was entered.
+        static void dump(const basic_profile<id_type>& profile_,
+            ostream& stream_)
+        {
+            std::vector<std::pair<std::size_t, id_type>> rules_;
+
+            examined(stream_);
+            stream_num(profile_._examined, stream_);
+            stream_ << std::endl;
+            consumed(stream_);
+            stream_num(profile_._consumed, stream_);
+            stream_ << std::endl << std::endl;
+
+            for (const auto& pair_ : profile_._rules)
+            {
+                rules_.emplace_back(pair_.second, pair_.first);
+            }
+
+            std::stable_sort(rules_.begin(), rules_.end(),
+                [](const std::pair<std::size_t, id_type>& lhs_,
+                    const std::pair<std::size_t, id_type>& rhs_)
+            {
+                return lhs_.first > rhs_.first;
+            });
+
+            for (const auto& pair_ : rules_)
+            {
+                rule_id(stream_);
+                stream_num(pair_.second, stream_);
+                matches(stream_);
+                stream_num(pair_.first, stream_);
+                stream_ << std::endl;
+            }
+
+            for (std::size_t dfa_ = 0, dfas_ = profile_._dfas.size();
+                dfa_ < dfas_; ++dfa_)
+            {
+                stream_ << std::endl;
+                lexer_state(stream_);
+                stream_num(dfa_, stream_);
+                lookups(stream_);
+                stream_num(profile_._dfas[dfa_], stream_);
+                stream_ << std::endl;
+
+                for (std::size_t state_ = 0,
+                    states_ = profile_._states[dfa_].size();
+                    state_ < states_; ++state_)
+                {
+                    if (profile_._states[dfa_][state_] != 0)
+                    {
+                        indent(stream_);
+                        state(stream_);
+                        stream_num(state_, stream_);
+                        entered(stream_);
+                        stream_num(profile_._states[dfa_][state_], stream_);
+                        stream_ << std::endl;
+                    }
+                }
+            }
+        }
+
     protected:
         using bool_vector_vector = typename rules::bool_vector_vector;
         using dfa_state = typename char_state_machine::state;
@@ -826,6 +892,96 @@ namespace lexertl
         {
             stream_ << U", dfa = ";
         }
+
+        static void examined(std::ostream& stream_)
+        {
+            stream_ << "Characters examined: ";
+        }
+
+        static void examined(std::wostream& stream_)
+        {
+            stream_ << L"Characters examined: ";
+        }
+
+        static void examined(std::basic_ostream<char32_t>& stream_)
+        {
+            stream_ << U"Characters examined: ";
+        }
+
+        static void consumed(std::ostream& stream_)
+        {
+            stream_ << "Characters consumed: ";
+        }
+
+        static void consumed(std::wostream& stream_)
+        {
+            stream_ << L"Characters consumed: ";
+        }
+
+        static void consumed(std::basic_ostream<char32_t>& stream_)
+        {
+            stream_ << U"Characters consumed: ";
+        }
+
+        static void rule_id(std::ostream& stream_)
+        {
+            stream_ << "Rule id: ";
+        }
+
+        static void rule_id(std::wostream& stream_)
+        {
+            stream_ << L"Rule id: ";
+        }
+
+        static void rule_id(std::basic_ostream<char32_t>& stream_)
+        {
+            stream_ << U"Rule id: ";
+        }
+
+        static void matches(std::ostream& stream_)
+        {
+            stream_ << ", matches = ";
+        }
+
+        static void matches(std::wostream& stream_)
+        {
+            stream_ << L", matches = ";
+        }
+
+        static void matches(std::basic_ostream<char32_t>& stream_)
+        {
+            stream_ << U", matches = ";
+        }
+
+        static void lookups(std::ostream& stream_)
+        {
+            stream_ << ", lookups = ";
+        }
+
+        static void lookups(std::wostream& stream_)
+        {
+            stream_ << L", lookups = ";
+        }
+
+        static void lookups(std::basic_ostream<char32_t>& stream_)
+        {
+            stream_ << U", lookups = ";
+        }
+
+        static void entered(std::ostream& stream_)
+        {
+            stream_ << ", entered = ";
+        }
+
+        static void entered(std::wostream& stream_)
+        {
+            stream_ << L", entered = ";
+        }
+
+        static void entered(std::basic_ostream<char32_t>& stream_)
+        {
+            stream_ << U", entered = ";
+        }
     };
 
     using debug = basic_debug<state_machine, char>;
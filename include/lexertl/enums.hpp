@@ -23,7 +23,7 @@ namespace lexertl
     enum class feature_bit
     {
         bol = 1, eol = 2, skip = 4, again = 8,
-        multi_state = 16, recursive = 32, advance = 64
+        multi_state = 16, recursive = 32, advance = 64, profile = 128
     };
     // End state flags:
     enum class state_bit
@@ -34,6 +34,12 @@ namespace lexertl
     {
         no, yes, hard
     };
+    // Phases of building a DFA, as timed by basic_build_observer:
+    enum class build_phase
+    {
+        build_tree, partition_charsets, closure, fix_clashes, append_dfa,
+        minimise
+    };
 }
 
 #endif
@@ -0,0 +1,451 @@
+// flat_internals.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_FLAT_INTERNALS_HPP
+#define LEXERTL_FLAT_INTERNALS_HPP
+
+#include "accelerate.hpp"
+#include "aligned_allocator.hpp"
+#include "internals.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lexertl
+{
+    namespace detail
+    {
+        // Narrow tables store npos and skip as the top two values of
+        // entry_type, so they must be widened back when read as an id.
+        template<typename id_type, typename entry_type>
+        id_type widen(const entry_type value_, const std::false_type&)
+        {
+            return value_;
+        }
+
+        template<typename id_type, typename entry_type>
+        id_type widen(const entry_type value_, const std::true_type&)
+        {
+            return value_ >= static_cast<entry_type>(~1) ?
+                static_cast<id_type>(~static_cast<id_type>
+                    (static_cast<entry_type>(~value_))) :
+                value_;
+        }
+
+        template<typename id_type, typename entry_type>
+        id_type widen(const entry_type value_)
+        {
+            return widen<id_type>(value_, std::integral_constant<bool,
+                (sizeof(entry_type) < sizeof(id_type))>());
+        }
+
+        // The entry type used for a table width, never wider than id_type.
+        template<typename entry_type, typename id_type>
+        using flat_entry = typename std::conditional
+            <(sizeof(entry_type) < sizeof(id_type)), entry_type,
+            id_type>::type;
+
+        // All tables of every lexer state in a single cache aligned block:
+        //
+        // [dfa alphabets][lookup 0]...[lookup n-1][dfa 0]...[dfa n-1]
+        //
+        // Every entry is _entry_size bytes wide, which is the narrowest of
+        // 1, 2 or 4 bytes (or sizeof(id_type)) that can hold every value in
+        // the machine. The alphabets occupy the first entries of the arena
+        // and each lookup table and DFA starts on a cache line boundary.
+        // _lookup and _dfa hold the offset (in entries) of each lexer
+        // state's tables.
+        //
+        // When _row_offsets is set, every transition (including the bol
+        // and eol entries) holds the offset of the target row, i.e. the row
+        // index already multiplied by the DFA alphabet.
+        //
+        // _accel_bits holds a bit per possible transition value of each
+        // DFA (starting at byte _accel_bit[dfa]), set when the target row
+        // is an accel_state. _accel holds an accel_state for every row
+        // (starting at _accel_row[dfa]). These tables are only built for
+        // machines that lookup() can accelerate (single byte char_type)
+        // and are empty otherwise.
+        template<typename id_type>
+        struct basic_flat_internals
+        {
+            using arena_vector = std::vector<unsigned char,
+                cache_aligned_allocator<unsigned char>>;
+            using offset_vector = std::vector<std::size_t>;
+            using accel_vector = std::vector<accel_state>;
+            using bits_vector = std::vector<unsigned char>;
+
+            id_type _eoi = 0;
+            id_type _features = 0;
+            std::size_t _entry_size = sizeof(id_type);
+            bool _row_offsets = false;
+            bool _paged = false;
+            offset_vector _lookup;
+            offset_vector _dfa;
+            offset_vector _dfa_size;
+            arena_vector _arena;
+            offset_vector _accel_bit;
+            offset_vector _accel_row;
+            bits_vector _accel_bits;
+            accel_vector _accel;
+
+            void clear()
+            {
+                _eoi = 0;
+                _features = 0;
+                _entry_size = sizeof(id_type);
+                _row_offsets = false;
+                _paged = false;
+                _lookup.clear();
+                _dfa.clear();
+                _dfa_size.clear();
+                _arena.clear();
+                _accel_bit.clear();
+                _accel_row.clear();
+                _accel_bits.clear();
+                _accel.clear();
+            }
+
+            bool empty() const
+            {
+                return _dfa.empty();
+            }
+
+            bool paged() const
+            {
+                return _paged;
+            }
+
+            // The tables are laid out in the order of the lexer states in
+            // order_ (by default in lexer state order). accel_ builds the
+            // accel_state tables.
+            void assign(const basic_internals<id_type>& internals_,
+                const bool row_offsets_, const bool accel_,
+                const offset_vector& order_ = offset_vector())
+            {
+                const std::size_t dfas_ = internals_._dfa.size();
+                std::size_t max_offset_ = 0;
+                std::size_t size_ = 0;
+
+                clear();
+                _eoi = internals_._eoi;
+                _features = internals_._features;
+                _paged = internals_.paged();
+
+                for (std::size_t i_ = 0; i_ < dfas_; ++i_)
+                {
+                    max_offset_ = std::max(max_offset_,
+                        internals_._dfa[i_].size() -
+                        internals_._dfa_alphabet[i_]);
+                }
+
+                // Fall back to row indexes if the offsets cannot be
+                // represented by id_type.
+                _row_offsets = row_offsets_ && max_offset_ < skip();
+                _entry_size = entry_size(internals_,
+                    _row_offsets ? max_offset_ : 0);
+                size_ = pad(dfas_);
+                _lookup.resize(dfas_);
+                _dfa.resize(dfas_);
+                _dfa_size.resize(dfas_);
+
+                for (std::size_t i_ = 0; i_ < dfas_; ++i_)
+                {
+                    const std::size_t idx_ = order_.empty() ? i_ : order_[i_];
+
+                    _lookup[idx_] = size_;
+                    size_ += pad(internals_._lookup[idx_].size());
+                }
+
+                for (std::size_t i_ = 0; i_ < dfas_; ++i_)
+                {
+                    const std::size_t idx_ = order_.empty() ? i_ : order_[i_];
+
+                    _dfa[idx_] = size_;
+                    _dfa_size[idx_] = internals_._dfa[idx_].size();
+                    size_ += pad(_dfa_size[idx_]);
+                }
+
+                _arena.resize(size_ * _entry_size, 0);
+
+                for (std::size_t i_ = 0; i_ < dfas_; ++i_)
+                {
+                    set(i_, internals_._dfa_alphabet[i_]);
+                    copy(internals_._lookup[i_], _lookup[i_]);
+                    copy_dfa(internals_._dfa[i_],
+                        internals_._dfa_alphabet[i_], _dfa[i_]);
+                }
+
+                if (accel_)
+                {
+                    assign_accel(internals_);
+                }
+            }
+
+            template<typename entry_type = id_type>
+            const entry_type* lookup(const std::size_t dfa_) const
+            {
+                return reinterpret_cast<const entry_type*>(_arena.data()) +
+                    _lookup[dfa_];
+            }
+
+            id_type dfa_alphabet(const std::size_t dfa_) const
+            {
+                return at(dfa_);
+            }
+
+            template<typename entry_type = id_type>
+            const entry_type* dfa(const std::size_t dfa_) const
+            {
+                return reinterpret_cast<const entry_type*>(_arena.data()) +
+                    _dfa[dfa_];
+            }
+
+            // Number of entries in the arena
+            std::size_t size() const
+            {
+                return _arena.size() / _entry_size;
+            }
+
+            // Read entry idx_ of the arena as an id_type
+            id_type at(const std::size_t idx_) const
+            {
+                switch (_entry_size)
+                {
+                case 1:
+                    return read<flat_entry<uint8_t, id_type>>(idx_);
+                case 2:
+                    return read<flat_entry<uint16_t, id_type>>(idx_);
+                case 4:
+                    return read<flat_entry<uint32_t, id_type>>(idx_);
+                default:
+                    return read<id_type>(idx_);
+                }
+            }
+
+            // Store val_ at entry idx_ of the arena
+            void set(const std::size_t idx_, const id_type val_)
+            {
+                switch (_entry_size)
+                {
+                case 1:
+                    write<flat_entry<uint8_t, id_type>>(idx_, val_);
+                    break;
+                case 2:
+                    write<flat_entry<uint16_t, id_type>>(idx_, val_);
+                    break;
+                case 4:
+                    write<flat_entry<uint32_t, id_type>>(idx_, val_);
+                    break;
+                default:
+                    write<id_type>(idx_, val_);
+                    break;
+                }
+            }
+
+            void swap(basic_flat_internals& internals_) noexcept
+            {
+                std::swap(_eoi, internals_._eoi);
+                std::swap(_features, internals_._features);
+                std::swap(_entry_size, internals_._entry_size);
+                std::swap(_row_offsets, internals_._row_offsets);
+                std::swap(_paged, internals_._paged);
+                _lookup.swap(internals_._lookup);
+                _dfa.swap(internals_._dfa);
+                _dfa_size.swap(internals_._dfa_size);
+                _arena.swap(internals_._arena);
+                _accel_bit.swap(internals_._accel_bit);
+                _accel_row.swap(internals_._accel_row);
+                _accel_bits.swap(internals_._accel_bits);
+                _accel.swap(internals_._accel);
+            }
+
+            // Round up to a whole number of cache lines
+            std::size_t pad(const std::size_t size_) const
+            {
+                const std::size_t line_ = cache_line < _entry_size ?
+                    1 : cache_line / _entry_size;
+
+                return (size_ + line_ - 1) / line_ * line_;
+            }
+
+        private:
+            static id_type npos()
+            {
+                return static_cast<id_type>(~0);
+            }
+
+            static id_type skip()
+            {
+                return static_cast<id_type>(~1);
+            }
+
+            static std::size_t entry_size
+                (const basic_internals<id_type>& internals_,
+                const std::size_t max_offset_)
+            {
+                std::size_t max_ = max_offset_;
+                auto update_ = [&max_](const id_type val_)
+                {
+                    if (val_ != npos() && val_ != skip() && val_ > max_)
+                        max_ = val_;
+                };
+                std::size_t size_ = sizeof(id_type);
+
+                for (const id_type alphabet_ : internals_._dfa_alphabet)
+                {
+                    update_(alphabet_);
+                }
+
+                for (const auto& lookup_ : internals_._lookup)
+                {
+                    for (const id_type val_ : lookup_)
+                    {
+                        update_(val_);
+                    }
+                }
+
+                for (const auto& dfa_ : internals_._dfa)
+                {
+                    for (const id_type val_ : dfa_)
+                    {
+                        update_(val_);
+                    }
+                }
+
+                // The top two values of each width are npos and skip.
+                if (max_ < std::numeric_limits<uint8_t>::max() - 1u)
+                    size_ = 1;
+                else if (max_ < std::numeric_limits<uint16_t>::max() - 1u)
+                    size_ = 2;
+                else if (max_ < std::numeric_limits<uint32_t>::max() - 1u)
+                    size_ = 4;
+
+                return size_ < sizeof(id_type) ? size_ : sizeof(id_type);
+            }
+
+            template<typename entry_type>
+            id_type read(const std::size_t idx_) const
+            {
+                entry_type val_ = 0;
+
+                std::memcpy(&val_, _arena.data() + idx_ * sizeof(entry_type),
+                    sizeof(entry_type));
+                return widen<id_type>(val_);
+            }
+
+            template<typename entry_type>
+            void write(const std::size_t idx_, const id_type val_)
+            {
+                const entry_type entry_ = static_cast<entry_type>(val_);
+
+                std::memcpy(_arena.data() + idx_ * sizeof(entry_type),
+                    &entry_, sizeof(entry_type));
+            }
+
+            void copy(const std::vector<id_type>& vec_, std::size_t idx_)
+            {
+                for (const id_type val_ : vec_)
+                {
+                    set(idx_++, val_);
+                }
+            }
+
+            void assign_accel(const basic_internals<id_type>& internals_)
+            {
+                for (std::size_t i_ = 0, dfas_ = internals_._dfa.size();
+                    i_ < dfas_; ++i_)
+                {
+                    const auto& lookup_ = internals_._lookup[i_];
+                    const auto& dfa_ = internals_._dfa[i_];
+                    const std::size_t alphabet_ = internals_._dfa_alphabet[i_];
+                    const std::size_t rows_ = dfa_.size() / alphabet_;
+                    const std::size_t bit_ = _accel_bits.size();
+
+                    _accel_bit.push_back(bit_);
+                    _accel_row.push_back(_accel.size());
+                    _accel_bits.resize(bit_ +
+                        ((_row_offsets ? dfa_.size() : rows_) + 7) / 8, 0);
+
+                    for (std::size_t row_ = 0; row_ < rows_; ++row_)
+                    {
+                        // Row 0 is the dead state.
+                        const accel_state accel_ = row_ == 0 ? accel_state() :
+                            make_accel(lookup_, &dfa_[row_ * alphabet_],
+                                static_cast<id_type>(row_));
+
+                        if (!accel_.empty())
+                        {
+                            const std::size_t val_ = _row_offsets ?
+                                row_ * alphabet_ : row_;
+
+                            _accel_bits[bit_ + val_ / 8] |=
+                                static_cast<unsigned char>(1 << (val_ % 8));
+                        }
+
+                        _accel.push_back(accel_);
+                    }
+                }
+            }
+
+            static accel_state make_accel(const std::vector<id_type>& lookup_,
+                const id_type* ptr_, const id_type row_)
+            {
+                accel_state accel_;
+                std::size_t size_ = 0;
+
+                for (std::size_t c_ = 0; c_ < 256; ++c_)
+                {
+                    if (ptr_[lookup_[c_]] != row_)
+                    {
+                        if (size_ == accel_state::max_exit)
+                            return accel_state();
+
+                        accel_._exit[size_++] = static_cast<unsigned char>(c_);
+                    }
+                }
+
+                accel_._size = static_cast<unsigned char>(size_);
+                return accel_;
+            }
+
+            void copy_dfa(const std::vector<id_type>& dfa_,
+                const id_type dfa_alphabet_, std::size_t idx_)
+            {
+                if (!_row_offsets)
+                {
+                    copy(dfa_, idx_);
+                    return;
+                }
+
+                for (std::size_t i_ = 0, size_ = dfa_.size(); i_ < size_;
+                    ++i_, ++idx_)
+                {
+                    const std::size_t col_ = i_ % dfa_alphabet_;
+
+                    // Row 0 column 0 holds the bol start state.
+                    if (i_ == 0 || col_ == *state_index::eol ||
+                        col_ >= *state_index::transitions)
+                    {
+                        set(idx_, static_cast<id_type>
+                            (dfa_[i_] * dfa_alphabet_));
+                    }
+                    else
+                    {
+                        set(idx_, dfa_[i_]);
+                    }
+                }
+            }
+        };
+    }
+}
+
+#endif
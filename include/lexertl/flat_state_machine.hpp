@@ -0,0 +1,148 @@
+// flat_state_machine.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_FLAT_STATE_MACHINE_HPP
+#define LEXERTL_FLAT_STATE_MACHINE_HPP
+
+#include "flat_internals.hpp"
+#include "profile.hpp"
+#include "sm_traits.hpp"
+#include "state_machine.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace lexertl
+{
+    // Read-only copy of a basic_state_machine with the tables of every
+    // lexer state laid out in one contiguous cache aligned allocation.
+    // Build (and minimise) a basic_state_machine as normal, then construct
+    // one of these from it for use with lookup().
+    // The single allocation is not faster in itself (the tables of a
+    // basic_state_machine stay just as cache resident in practice); it is
+    // what lets the tables be narrowed, stored as row offsets, extended
+    // with accel_state data and ordered by profile without changing
+    // basic_state_machine.
+    // By default transitions are stored as row offsets so that lookup()
+    // does not have to multiply a row index by the DFA alphabet for every
+    // character. Pass row_offsets_ = false to keep plain row indexes.
+    // Given a basic_profile, the tables of the lexer states it saw used
+    // most are laid out first, leaving the rarely used ones at the end.
+    template<typename char_type, typename id_ty = uint16_t>
+    class basic_flat_state_machine
+    {
+    public:
+        using id_type = id_ty;
+        using traits =
+            basic_sm_traits<char_type, id_type,
+            (sizeof(char_type) > 1), true, true>;
+        using internals = detail::basic_flat_internals<id_type>;
+        using state_machine = basic_state_machine<char_type, id_type>;
+
+        static_assert(std::is_unsigned<id_type>::value,
+            "Your id type is signed");
+
+        basic_flat_state_machine() = default;
+
+        explicit basic_flat_state_machine(const state_machine& sm_,
+            const bool row_offsets_ = true)
+        {
+            assign(sm_, row_offsets_);
+        }
+
+        basic_flat_state_machine(const state_machine& sm_,
+            const basic_profile<id_type>& profile_,
+            const bool row_offsets_ = true)
+        {
+            assign(sm_, profile_, row_offsets_);
+        }
+
+        void assign(const state_machine& sm_, const bool row_offsets_ = true)
+        {
+            internals internals_;
+
+            internals_.assign(sm_.data(), row_offsets_, accel());
+            _internals.swap(internals_);
+        }
+
+        void assign(const state_machine& sm_,
+            const basic_profile<id_type>& profile_,
+            const bool row_offsets_ = true)
+        {
+            typename internals::offset_vector order_(sm_.data()._dfa.size());
+            internals internals_;
+
+            for (std::size_t i_ = 0, size_ = order_.size(); i_ < size_; ++i_)
+            {
+                order_[i_] = i_;
+            }
+
+            std::stable_sort(order_.begin(), order_.end(),
+                [&profile_](const std::size_t lhs_, const std::size_t rhs_)
+            {
+                return profile_.starts(lhs_) > profile_.starts(rhs_);
+            });
+            internals_.assign(sm_.data(), row_offsets_, accel(), order_);
+            _internals.swap(internals_);
+        }
+
+        void clear()
+        {
+            _internals.clear();
+        }
+
+        internals& data()
+        {
+            return _internals;
+        }
+
+        const internals& data() const
+        {
+            return _internals;
+        }
+
+        bool empty() const
+        {
+            return _internals.empty();
+        }
+
+        id_type eoi() const
+        {
+            return _internals._eoi;
+        }
+
+        static id_type npos()
+        {
+            return static_cast<id_type>(~0);
+        }
+
+        static id_type skip()
+        {
+            return static_cast<id_type>(~1);
+        }
+
+        void swap(basic_flat_state_machine& rhs_) noexcept
+        {
+            _internals.swap(rhs_._internals);
+        }
+
+    private:
+        internals _internals;
+
+        // lookup() only accelerates single byte input, so there is no
+        // point in building the tables for wider characters.
+        static bool accel()
+        {
+            return !traits::compressed;
+        }
+    };
+
+    using flat_state_machine = basic_flat_state_machine<char>;
+    using wflat_state_machine = basic_flat_state_machine<wchar_t>;
+    using u32flat_state_machine = basic_flat_state_machine<char32_t>;
+}
+
+#endif
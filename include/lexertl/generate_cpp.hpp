@@ -8,12 +8,15 @@
 
 #include "enum_operator.hpp"
 #include "enums.hpp"
+#include "flat_state_machine.hpp"
+#include "runtime_error.hpp"
 #include "state_machine.hpp"
 
 #include <ios>
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace lexertl
 {
@@ -26,11 +29,313 @@ namespace lexertl
             const basic_state_machine<char_type, id_type>& sm_,
             const bool pointers_, std::ostream& os_)
         {
-            using sm = basic_state_machine<char_type, id_type>;
+            generate_ex(name_, sm_, pointers_, os_);
+        }
+
+        template<typename char_type, typename id_type>
+        static void generate
+        (const std::string& name_,
+            const basic_flat_state_machine<char_type, id_type>& sm_,
+            const bool pointers_, std::ostream& os_)
+        {
+            generate_ex(name_, sm_, pointers_, os_);
+        }
+
+        template<typename char_type, typename id_type>
+        static void dump_tables
+        (const basic_state_machine<char_type, id_type>& sm_,
+            const std::size_t tabs_, const bool pointers_, std::ostream& os_)
+        {
+            const auto& internals_ = sm_.data();
+            const std::size_t dfas_ = internals_._lookup.size();
+
+            output_tabs(tabs_, os_);
+            os_ << "static const id_type lookup";
+
+            if (dfas_ > 1)
+            {
+                os_ << "s_[][" << 256;
+            }
+            else
+            {
+                os_ << "_[";
+            }
+
+            os_ << "] = \n";
+            output_tabs(tabs_ + 1, os_);
+
+            if (dfas_ > 1)
+            {
+                os_ << '{';
+            }
+
+            for (std::size_t l_ = 0; l_ < dfas_; ++l_)
+            {
+                dump_lookup(&internals_._lookup[l_].front(), tabs_ + 1, os_);
+
+                if (l_ + 1 < dfas_)
+                {
+                    os_ << ",\n";
+                    output_tabs(tabs_ + 1, os_);
+                }
+            }
+
+            if (dfas_ > 1)
+            {
+                os_ << '}';
+            }
+
+            os_ << ";\n";
+            output_tabs(tabs_, os_);
+            os_ << "static const id_type dfa_alphabet";
+
+            if (dfas_ > 1)
+            {
+                os_ << "s_[" << std::dec << dfas_ << "] = {";
+            }
+            else
+            {
+                os_ << "_ = ";
+            }
+
+            // We want numbers regardless of id_type.
+            os_ << "0x" << std::hex << static_cast<std::size_t>
+                (internals_._dfa_alphabet[0]);
+
+            for (std::size_t col_ = 1; col_ < dfas_; ++col_)
+            {
+                // We want numbers regardless of id_type.
+                os_ << ", 0x" << std::hex <<
+                    static_cast<std::size_t>(internals_._dfa_alphabet[col_]);
+            }
+
+            if (dfas_ > 1)
+            {
+                os_ << '}';
+            }
+
+            os_ << ";\n";
+
+            // DFAs are usually different sizes, so dump separately
+            for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+            {
+                const id_type dfa_alphabet_ = internals_._dfa_alphabet[dfa_];
+                const std::size_t rows_ = internals_._dfa[dfa_].size() /
+                    dfa_alphabet_;
+                const id_type* ptr_ = &internals_._dfa[dfa_].front();
+                std::string dfa_name_ = "dfa";
+
+                output_tabs(tabs_, os_);
+                os_ << "static const ";
+
+                if (pointers_)
+                {
+                    os_ << "void*";
+                }
+                else
+                {
+                    os_ << "id_type";
+                }
+
+                os_ << ' ' << dfa_name_;
+
+                if (dfas_ > 1)
+                {
+                    std::ostringstream ss_;
+
+                    ss_ << dfa_;
+                    dfa_name_ += ss_.str();
+                    os_ << dfa_;
+                }
+
+                dfa_name_ += '_';
+                os_ << "_[] = {";
+
+                for (std::size_t row_ = 0; row_ < rows_; ++row_)
+                {
+                    dump_row(row_ == 0, ptr_, dfa_name_, dfa_alphabet_,
+                        dfa_alphabet_, pointers_, os_);
+
+                    if (row_ + 1 < rows_)
+                    {
+                        os_ << ",\n";
+                        output_tabs(tabs_ + 1, os_);
+                    }
+                }
+
+                os_ << "};\n";
+            }
+
+            if (dfas_ > 1)
+            {
+                output_tabs(tabs_, os_);
+                os_ << "static const ";
+
+                if (pointers_)
+                {
+                    os_ << "void* const";
+                }
+                else
+                {
+                    os_ << "id_type";
+                }
+
+                os_ << "* dfas_[] = {dfa0_";
+
+                for (std::size_t col_ = 1; col_ < dfas_; ++col_)
+                {
+                    os_ << ", dfa" << col_ << '_';
+                }
+
+                os_ << "};\n";
+            }
+
+            os_ << std::dec;
+        }
+
+        // Emits every table in one cache aligned struct, mirroring the arena
+        // of basic_flat_internals, then aliases the names that generate()
+        // expects. Entries are emitted as id_type whatever the width of the
+        // arena.
+        template<typename char_type, typename id_type>
+        static void dump_tables
+        (const basic_flat_state_machine<char_type, id_type>& sm_,
+            const std::size_t tabs_, const bool pointers_, std::ostream& os_)
+        {
+            const auto& internals_ = sm_.data();
+            const std::size_t dfas_ = internals_._dfa.size();
+            const char* entry_ = pointers_ ? "const void*" : "id_type";
+
+            output_tabs(tabs_, os_);
+            os_ << "static const struct\n";
+            output_tabs(tabs_, os_);
+            os_ << "{\n";
+            output_tabs(tabs_ + 1, os_);
+            os_ << "alignas(64) id_type dfa_alphabets_[" << std::dec <<
+                dfas_ << "];\n";
+            output_tabs(tabs_ + 1, os_);
+            os_ << "alignas(64) id_type lookups_[" << dfas_ << "][256];\n";
+
+            for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+            {
+                output_tabs(tabs_ + 1, os_);
+                os_ << "alignas(64) " << entry_ << " dfa" << dfa_ << "_[" <<
+                    internals_._dfa_size[dfa_] << "];\n";
+            }
+
+            output_tabs(tabs_, os_);
+            os_ << "} tables_ = {\n";
+            output_tabs(tabs_ + 1, os_);
+            // We want numbers regardless of id_type.
+            os_ << "{0x" << std::hex << static_cast<std::size_t>
+                (internals_.dfa_alphabet(0));
+
+            for (std::size_t col_ = 1; col_ < dfas_; ++col_)
+            {
+                // We want numbers regardless of id_type.
+                os_ << ", 0x" << std::hex <<
+                    static_cast<std::size_t>(internals_.dfa_alphabet(col_));
+            }
+
+            os_ << "},\n";
+            output_tabs(tabs_ + 1, os_);
+            os_ << '{';
+
+            for (std::size_t l_ = 0; l_ < dfas_; ++l_)
+            {
+                const std::vector<id_type> lookup_ =
+                    widen_table(internals_, internals_._lookup[l_], 256);
+
+                dump_lookup(&lookup_.front(), tabs_ + 1, os_);
+                os_ << ",\n";
+                output_tabs(tabs_ + 1, os_);
+            }
+
+            os_ << '}';
+
+            for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+            {
+                const id_type dfa_alphabet_ = internals_.dfa_alphabet(dfa_);
+                const std::size_t rows_ = internals_._dfa_size[dfa_] /
+                    dfa_alphabet_;
+                const std::vector<id_type> table_ = widen_table(internals_,
+                    internals_._dfa[dfa_], internals_._dfa_size[dfa_]);
+                const id_type* ptr_ = &table_.front();
+                std::ostringstream ss_;
+
+                ss_ << "tables_.dfa" << dfa_ << '_';
+                os_ << ",\n";
+                output_tabs(tabs_ + 1, os_);
+                os_ << '{';
+
+                for (std::size_t row_ = 0; row_ < rows_; ++row_)
+                {
+                    dump_row(row_ == 0, ptr_, ss_.str(), dfa_alphabet_,
+                        internals_._row_offsets ? 1 : dfa_alphabet_,
+                        pointers_, os_);
+
+                    if (row_ + 1 < rows_)
+                    {
+                        os_ << ",\n";
+                        output_tabs(tabs_ + 1, os_);
+                    }
+                }
+
+                os_ << '}';
+            }
+
+            os_ << "};\n";
+            output_tabs(tabs_, os_);
+
+            if (dfas_ > 1)
+            {
+                os_ << "static const auto& lookups_ = tables_.lookups_;\n";
+                output_tabs(tabs_, os_);
+                os_ << "static const auto& dfa_alphabets_ = "
+                    "tables_.dfa_alphabets_;\n";
+                output_tabs(tabs_, os_);
+                os_ << "static const " <<
+                    (pointers_ ? "void* const" : "id_type") <<
+                    "* dfas_[] = {tables_.dfa0_";
+
+                for (std::size_t col_ = 1; col_ < dfas_; ++col_)
+                {
+                    os_ << ", tables_.dfa" << std::dec << col_ << '_';
+                }
+
+                os_ << "};\n";
+            }
+            else
+            {
+                os_ << "static const auto& lookup_ = tables_.lookups_[0];\n";
+                output_tabs(tabs_, os_);
+                // We want a number regardless of id_type.
+                os_ << "static const id_type dfa_alphabet_ = 0x" <<
+                    std::hex << static_cast<std::size_t>
+                    (internals_.dfa_alphabet(0)) << ";\n";
+                output_tabs(tabs_, os_);
+                os_ << "static const auto& dfa_ = tables_.dfa0_;\n";
+            }
+
+            os_ << std::dec;
+        }
+
+    protected:
+        template<typename sm>
+        static void generate_ex(const std::string& name_, const sm& sm_,
+            const bool pointers_, std::ostream& os_)
+        {
             using internals = typename sm::internals;
             const internals& internals_ = sm_.data();
+            const bool offsets_ = row_offsets(sm_);
             std::size_t additional_tabs_ = 0;
 
+            if (internals_.paged())
+            {
+                throw runtime_error("table_based_cpp does not support "
+                    "paged lookup tables.");
+            }
+
             os_ << "template<typename iter_type, typename id_type>\n";
             os_ << "void " << name_ << " (lexertl::";
 
@@ -259,7 +564,7 @@ namespace lexertl
                 }
                 else
                 {
-                    os_ << "&dfa_[state_ * dfa_alphabet_];\n";
+                    os_ << row("state_", offsets_) << ";\n";
                 }
 
                 os_ << "        }\n";
@@ -296,7 +601,7 @@ namespace lexertl
                 }
                 else
                 {
-                    os_ << "&dfa_[EOL_state_ * dfa_alphabet_]";
+                    os_ << row("EOL_state_", offsets_);
                 }
 
                 os_ << ";\n";
@@ -307,7 +612,7 @@ namespace lexertl
             }
 
             output_char_loop(internals_._features, additional_tabs_, pointers_,
-                os_, std::integral_constant<bool,
+                offsets_, os_, std::integral_constant<bool,
                 (sizeof(typename sm::traits::input_char_type) > 1)>());
 
             if (internals_._features & *feature_bit::eol)
@@ -464,7 +769,7 @@ namespace lexertl
                 }
                 else
                 {
-                    os_ << "&dfa_[EOL_state_ * dfa_alphabet_]";
+                    os_ << row("EOL_state_", offsets_);
                 }
 
                 os_ << ";\n\n";
@@ -667,194 +972,84 @@ namespace lexertl
             os_ << "}\n";
         }
 
+
         template<typename char_type, typename id_type>
-        static void dump_tables
-        (const basic_state_machine<char_type, id_type>& sm_,
-            const std::size_t tabs_, const bool pointers_, std::ostream& os_)
+        static bool row_offsets
+            (const basic_state_machine<char_type, id_type>&)
         {
-            const auto& internals_ = sm_.data();
-            const std::size_t lookup_divisor_ = 8;
-            // Lookup is always 256 entries long now
-            const std::size_t lookup_quotient_ = 256 / lookup_divisor_;
-            const std::size_t dfas_ = internals_._lookup.size();
-
-            output_tabs(tabs_, os_);
-            os_ << "static const id_type lookup";
-
-            if (dfas_ > 1)
-            {
-                os_ << "s_[][" << 256;
-            }
-            else
-            {
-                os_ << "_[";
-            }
-
-            os_ << "] = \n";
-            output_tabs(tabs_ + 1, os_);
-
-            if (dfas_ > 1)
-            {
-                os_ << '{';
-            }
-
-            for (std::size_t l_ = 0; l_ < dfas_; ++l_)
-            {
-                const id_type* ptr_ = &internals_._lookup[l_].front();
-
-                // We want numbers regardless of id_type.
-                os_ << "{0x" << std::hex << static_cast<std::size_t>(*ptr_++);
-
-                for (std::size_t col_ = 1; col_ < lookup_divisor_; ++col_)
-                {
-                    // We want numbers regardless of id_type.
-                    os_ << ", 0x" << std::hex <<
-                        static_cast<std::size_t>(*ptr_++);
-                }
-
-                for (std::size_t row_ = 1; row_ < lookup_quotient_; ++row_)
-                {
-                    os_ << ",\n";
-                    output_tabs(tabs_ + 1, os_);
-                    // We want numbers regardless of id_type.
-                    os_ << "0x" << std::hex <<
-                        static_cast<std::size_t>(*ptr_++);
+            return false;
+        }
 
-                    for (std::size_t col_ = 1; col_ < lookup_divisor_; ++col_)
-                    {
-                        // We want numbers regardless of id_type.
-                        os_ << ", 0x" << std::hex <<
-                            static_cast<std::size_t>(*ptr_++);
-                    }
-                }
+        template<typename char_type, typename id_type>
+        static bool row_offsets
+            (const basic_flat_state_machine<char_type, id_type>& sm_)
+        {
+            return sm_.data()._row_offsets;
+        }
 
-                os_ << '}';
+        // The expression for the row of the DFA that state_ refers to
+        static std::string row(const std::string& state_,
+            const bool offsets_)
+        {
+            return offsets_ ? "&dfa_[" + state_ + ']' :
+                "&dfa_[" + state_ + " * dfa_alphabet_]";
+        }
 
-                if (l_ + 1 < dfas_)
-                {
-                    os_ << ",\n";
-                    output_tabs(tabs_ + 1, os_);
-                }
-            }
+        template<typename id_type>
+        static std::vector<id_type> widen_table
+            (const detail::basic_flat_internals<id_type>& internals_,
+            std::size_t idx_, const std::size_t size_)
+        {
+            std::vector<id_type> table_(size_);
 
-            if (dfas_ > 1)
+            for (auto& entry_ : table_)
             {
-                os_ << '}';
+                entry_ = internals_.at(idx_++);
             }
 
-            os_ << ";\n";
-            output_tabs(tabs_, os_);
-            os_ << "static const id_type dfa_alphabet";
+            return table_;
+        }
 
-            if (dfas_ > 1)
-            {
-                os_ << "s_[" << std::dec << dfas_ << "] = {";
-            }
-            else
-            {
-                os_ << "_ = ";
-            }
+        // Lookup is always 256 entries long now
+        template<typename id_type>
+        static void dump_lookup(const id_type* ptr_, const std::size_t tabs_,
+            std::ostream& os_)
+        {
+            const std::size_t lookup_divisor_ = 8;
+            const std::size_t lookup_quotient_ = 256 / lookup_divisor_;
 
             // We want numbers regardless of id_type.
-            os_ << "0x" << std::hex << static_cast<std::size_t>
-                (internals_._dfa_alphabet[0]);
+            os_ << "{0x" << std::hex << static_cast<std::size_t>(*ptr_++);
 
-            for (std::size_t col_ = 1; col_ < dfas_; ++col_)
+            for (std::size_t col_ = 1; col_ < lookup_divisor_; ++col_)
             {
                 // We want numbers regardless of id_type.
-                os_ << ", 0x" << std::hex <<
-                    static_cast<std::size_t>(internals_._dfa_alphabet[col_]);
+                os_ << ", 0x" << std::hex << static_cast<std::size_t>(*ptr_++);
             }
 
-            if (dfas_ > 1)
-            {
-                os_ << '}';
-            }
-
-            os_ << ";\n";
-
-            // DFAs are usually different sizes, so dump separately
-            for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+            for (std::size_t row_ = 1; row_ < lookup_quotient_; ++row_)
             {
-                const id_type dfa_alphabet_ = internals_._dfa_alphabet[dfa_];
-                const std::size_t rows_ = internals_._dfa[dfa_].size() /
-                    dfa_alphabet_;
-                const id_type* ptr_ = &internals_._dfa[dfa_].front();
-                std::string dfa_name_ = "dfa";
-
+                os_ << ",\n";
                 output_tabs(tabs_, os_);
-                os_ << "static const ";
-
-                if (pointers_)
-                {
-                    os_ << "void*";
-                }
-                else
-                {
-                    os_ << "id_type";
-                }
-
-                os_ << ' ' << dfa_name_;
-
-                if (dfas_ > 1)
-                {
-                    std::ostringstream ss_;
-
-                    ss_ << dfa_;
-                    dfa_name_ += ss_.str();
-                    os_ << dfa_;
-                }
-
-                dfa_name_ += '_';
-                os_ << "_[] = {";
-
-                for (std::size_t row_ = 0; row_ < rows_; ++row_)
-                {
-                    dump_row(row_ == 0, ptr_, dfa_name_, dfa_alphabet_,
-                        pointers_, os_);
-
-                    if (row_ + 1 < rows_)
-                    {
-                        os_ << ",\n";
-                        output_tabs(tabs_ + 1, os_);
-                    }
-                }
-
-                os_ << "};\n";
-            }
-
-            if (dfas_ > 1)
-            {
-                output_tabs(tabs_, os_);
-                os_ << "static const ";
-
-                if (pointers_)
-                {
-                    os_ << "void* const";
-                }
-                else
-                {
-                    os_ << "id_type";
-                }
-
-                os_ << "* dfas_[] = {dfa0_";
+                // We want numbers regardless of id_type.
+                os_ << "0x" << std::hex << static_cast<std::size_t>(*ptr_++);
 
-                for (std::size_t col_ = 1; col_ < dfas_; ++col_)
+                for (std::size_t col_ = 1; col_ < lookup_divisor_; ++col_)
                 {
-                    os_ << ", dfa" << col_ << '_';
+                    // We want numbers regardless of id_type.
+                    os_ << ", 0x" << std::hex <<
+                        static_cast<std::size_t>(*ptr_++);
                 }
-
-                os_ << "};\n";
             }
 
-            os_ << std::dec;
+            os_ << '}';
         }
 
-    protected:
         template<typename id_type>
         static void dump_row(const bool first_, const id_type*& ptr_,
             const std::string& dfa_name_, const id_type dfa_alphabet_,
-            const bool pointers_, std::ostream& os_)
+            const std::size_t row_size_, const bool pointers_,
+            std::ostream& os_)
         {
             if (pointers_)
             {
@@ -864,7 +1059,7 @@ namespace lexertl
                 {
                     // We want numbers regardless of id_type.
                     os_ << dfa_name_ << " + 0x" << std::hex <<
-                        static_cast<std::size_t>(*ptr_++) * dfa_alphabet_;
+                        static_cast<std::size_t>(*ptr_++) * row_size_;
                 }
                 else if (!zero_)
                 {
@@ -913,7 +1108,7 @@ namespace lexertl
                     {
                         // We want numbers regardless of id_type.
                         os_ << dfa_name_ + " + 0x" << std::hex <<
-                            static_cast<std::size_t>(*ptr_) * dfa_alphabet_;
+                            static_cast<std::size_t>(*ptr_) * row_size_;
                     }
                 }
             }
@@ -943,7 +1138,7 @@ namespace lexertl
         template<typename id_type>
         static void output_char_loop(const id_type features_,
             const std::size_t additional_tabs_, const bool pointers_,
-            std::ostream& os_, const std::false_type&)
+            const bool offsets_, std::ostream& os_, const std::false_type&)
         {
             output_tabs(additional_tabs_, os_);
             os_ << "        const char_type prev_char_ = *curr_++;\n";
@@ -1023,7 +1218,7 @@ namespace lexertl
             }
             else
             {
-                os_ << "&dfa_[state_ * dfa_alphabet_]";
+                os_ << row("state_", offsets_);
             }
 
             os_ << ";\n";
@@ -1032,7 +1227,7 @@ namespace lexertl
         template<typename id_type>
         static void output_char_loop(const id_type features_,
             const std::size_t additional_tabs_, const bool pointers_,
-            std::ostream& os_, const std::true_type&)
+            const bool offsets_, std::ostream& os_, const std::true_type&)
         {
             output_tabs(additional_tabs_, os_);
             os_ << "        const std::size_t bytes_ =\n";
@@ -1111,7 +1306,7 @@ namespace lexertl
             }
             else
             {
-                os_ << "&dfa_[state_ * dfa_alphabet_]";
+                os_ << row("state_", offsets_);
             }
 
             os_ << ";\n";
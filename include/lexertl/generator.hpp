@@ -6,6 +6,7 @@
 #ifndef LEXERTL_GENERATOR_HPP
 #define LEXERTL_GENERATOR_HPP
 
+#include "build_observer.hpp"
 #include "char_traits.hpp"
 #include "enum_operator.hpp"
 #include "enums.hpp"
@@ -18,11 +19,22 @@
 #include "runtime_error.hpp"
 #include "state_machine.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -30,19 +42,24 @@ namespace lexertl
 {
     template<typename rules, typename sm,
         typename char_traits = basic_char_traits
-        <typename sm::traits::input_char_type> >
+        <typename sm::traits::input_char_type>,
+        typename traits = typename sm::traits>
         class basic_generator
     {
     public:
         using id_type = typename rules::id_type;
         using rules_char_type = typename rules::rules_char_type;
-        using sm_traits = typename sm::traits;
+        using sm_traits = traits;
         using parser = detail::basic_parser<rules_char_type, sm_traits>;
         using charset_map = typename parser::charset_map;
         using node = typename parser::node;
         using node_ptr_vector = typename parser::node_ptr_vector;
+        using build_observer = basic_build_observer<id_type>;
 
-        static void build(const rules& rules_, sm& sm_)
+        // observer_ (if any) is told how long each phase takes along with
+        // the sizes of the intermediate structures.
+        static void build(const rules& rules_, sm& sm_,
+            const observer_ptr<build_observer> observer_ = nullptr)
         {
             const auto size_ =
                 static_cast<id_type>(rules_.statemap().size());
@@ -59,48 +76,145 @@ namespace lexertl
 
             for (id_type index_ = 0; index_ < size_; ++index_)
             {
-                if (rules_.regexes()[index_].empty())
-                {
-                    std::ostringstream ss_;
+                // partitioned charset list
+                charset_list charset_list_;
 
-                    ss_ << "Lexer states with no rules are not allowed "
-                        "(lexer state " << index_ << ".)";
-                    throw runtime_error(ss_.str());
-                }
-                else
+                build_state(rules_, index_, unique_id_, node_ptr_vector_,
+                    internals_, charset_list_, used_ids_, 1, observer_);
+
+                auto start_ = now(observer_);
+
+                append_dfa(charset_list_, internals_, temp_sm_, index_,
+                    lookup());
+                end_phase(observer_, index_, build_phase::append_dfa, start_);
+            }
+
+            check_suppressed(rules_, unique_id_, used_ids_);
+            // If you get a compile error here the id_type from rules and
+            // state machine do no match.
+            create(internals_, temp_sm_, rules_.features(), lookup());
+            sm_.swap(temp_sm_);
+        }
+
+        // As build(), but builds the DFAs of different lexer states on up
+        // to threads_ threads (including the calling thread). When there
+        // are more threads than lexer states, the spare threads share the
+        // subset construction of each DFA. The result is the same as
+        // build() gives, as is the exception thrown if more than one
+        // lexer state has an error.
+        static void build_parallel(const rules& rules_, sm& sm_,
+            std::size_t threads_ = std::thread::hardware_concurrency())
+        {
+            const auto size_ =
+                static_cast<id_type>(rules_.statemap().size());
+            internals internals_;
+            sm temp_sm_;
+            std::vector<charset_list> charset_lists_(size_);
+            std::vector<std::set<id_type>> used_ids_(size_);
+            std::vector<std::exception_ptr> errors_(size_);
+            // Each lexer state numbers its rules on from the previous one,
+            // so the last entry is the total number of rules.
+            std::vector<id_type> unique_ids_(size_ + 1, 0);
+            std::atomic<std::size_t> next_(0);
+            std::vector<std::future<void>> futures_;
+            std::set<id_type> all_used_ids_;
+
+            if (threads_ == 0)
+                threads_ = 1;
+
+            // Threads left over once every lexer state has one go to the
+            // subset construction of each lexer state.
+            const std::size_t outer_threads_ =
+                std::max<std::size_t>(std::min<std::size_t>(threads_, size_),
+                    1);
+            const std::size_t inner_threads_ = threads_ / outer_threads_;
+
+            internals_._eoi = rules_.eoi();
+            internals_.add_states(size_);
+
+            for (id_type index_ = 0; index_ < size_; ++index_)
+            {
+                unique_ids_[index_ + 1] = static_cast<id_type>
+                    (unique_ids_[index_] + rules_.regexes()[index_].size());
+            }
+
+            // Each lexer state only writes to its own slots of
+            // internals_ and the vectors above.
+            auto worker_ = [&]()
+            {
+                for (std::size_t index_ = next_++; index_ < size_;
+                    index_ = next_++)
                 {
-                    // Note that the following variables are per DFA.
-                    // Map of regex charset tokens (strings) to index
-                    charset_map charset_map_;
-                    // Used to fix up $ and \n clashes.
-                    id_type cr_id_ = sm_traits::npos();
-                    id_type nl_id_ = sm_traits::npos();
-                    // Regex syntax tree
-                    observer_ptr<node> root_ = build_tree(rules_, index_,
-                        node_ptr_vector_, charset_map_, cr_id_, nl_id_,
-                        unique_id_);
-
-                    check_zero_len(rules_, root_);
-                    build_dfa(charset_map_, root_, internals_, temp_sm_, index_,
-                        cr_id_, nl_id_, rules_.flags(), used_ids_);
-
-                    if (internals_._dfa[index_].size() /
-                        internals_._dfa_alphabet[index_] >= sm_traits::npos())
+                    const auto dfa_ = static_cast<id_type>(index_);
+
+                    try
                     {
-                        // Overflow
-                        throw runtime_error("The id_type you have chosen "
-                            "cannot hold this many DFA rows.");
+                        node_ptr_vector node_ptr_vector_;
+
+                        build_state(rules_, dfa_, unique_ids_[index_],
+                            node_ptr_vector_, internals_,
+                            charset_lists_[index_], used_ids_[index_],
+                            inner_threads_, nullptr);
+                    }
+                    catch (...)
+                    {
+                        errors_[index_] = std::current_exception();
                     }
                 }
+            };
+
+            for (std::size_t i_ = 1; i_ < outer_threads_; ++i_)
+            {
+                futures_.push_back(std::async(std::launch::async, worker_));
             }
 
-            check_suppressed(rules_, unique_id_, used_ids_);
-            // If you get a compile error here the id_type from rules and
-            // state machine do no match.
+            worker_();
+
+            for (auto& future_ : futures_)
+            {
+                future_.get();
+            }
+
+            for (id_type index_ = 0; index_ < size_; ++index_)
+            {
+                // Report the same error as build() would
+                if (errors_[index_])
+                    std::rethrow_exception(errors_[index_]);
+
+                append_dfa(charset_lists_[index_], internals_, temp_sm_,
+                    index_, lookup());
+                all_used_ids_.insert(used_ids_[index_].cbegin(),
+                    used_ids_[index_].cend());
+            }
+
+            check_suppressed(rules_, unique_ids_.back(), all_used_ids_);
             create(internals_, temp_sm_, rules_.features(), lookup());
             sm_.swap(temp_sm_);
         }
 
+        // Numbers the leaf and end nodes added from first_ onwards,
+        // returning how many there are.
+        static std::size_t number_positions(node_ptr_vector& node_ptr_vector_,
+            const std::size_t first_)
+        {
+            std::size_t positions_ = 0;
+
+            for (std::size_t index_ = first_, size_ = node_ptr_vector_.size();
+                index_ < size_; ++index_)
+            {
+                node& node_ = *node_ptr_vector_[index_];
+                const auto type_ = node_.what_type();
+
+                if (type_ == node::node_type::LEAF ||
+                    type_ == node::node_type::END)
+                {
+                    node_.position(positions_++);
+                }
+            }
+
+            return positions_;
+        }
+
         static observer_ptr<node> build_tree(const rules& rules_,
             const std::size_t dfa_, node_ptr_vector& node_ptr_vector_,
             charset_map& charset_map_, id_type& cr_id_, id_type& nl_id_,
@@ -143,9 +257,8 @@ namespace lexertl
                     *push_dfa_iter_, *pop_dfa_iter_, cr_id_, nl_id_,
                     (rules_.features()[dfa_] & *feature_bit::bol) != 0);
 
-                node_ptr_vector_.push_back(std::make_unique<selection_node>
-                    (root_, rhs_));
-                root_ = node_ptr_vector_.back().get();
+                root_ = node_ptr_vector_.template create<selection_node>
+                    (root_, rhs_);
 
                 ++regex_iter_;
                 ++id_iter_;
@@ -159,7 +272,10 @@ namespace lexertl
         }
 
     protected:
-        using compressed = std::integral_constant<bool, sm_traits::compressed>;
+        // UTF-8 sequences keep '\r' and '\n' as single bytes, so eol
+        // clashes are fixed as for an uncompressed machine.
+        using compressed = std::integral_constant<bool,
+            sm_traits::compressed && !sm_traits::utf8>;
         using equivset = detail::basic_equivset<id_type>;
         using equivset_list = std::list<std::unique_ptr<equivset>>;
         using equivset_ptr = std::unique_ptr<equivset>;
@@ -175,8 +291,15 @@ namespace lexertl
         using index_set_vector = std::vector<index_set>;
         using is_dfa = std::integral_constant<bool, sm_traits::is_dfa>;
         using lookup = std::integral_constant<bool, sm_traits::lookup>;
-        using node_set = std::set<observer_ptr<const node>>;
-        using node_set_vector = std::vector<std::unique_ptr<node_set>>;
+        // Wide characters that are not compressed need a paged lookup
+        using paged = std::integral_constant<bool, sm_traits::lookup &&
+            !sm_traits::compressed && (sizeof(sm_char_type) > 1)>;
+        // Sorted node positions
+        using node_set = std::vector<std::size_t>;
+        using node_set_vector = std::vector<node_set>;
+        // The columns of a DFA row before its transitions
+        using state_header =
+            std::array<id_type, +state_index::transitions>;
         using node_vector = typename node::node_vector;
         using node_vector_vector = std::vector<std::unique_ptr<node_vector>>;
         using selection_node = typename parser::selection_node;
@@ -185,23 +308,76 @@ namespace lexertl
             typename rules::std_string_vector_vector;
         using string_token = typename parser::string_token;
 
+        // Builds the DFA of lexer state index_ into internals_, leaving
+        // its partitioned charsets in charset_list_ for append_dfa().
+        // unique_id_ is that of the last rule of the previous lexer state
+        // and is advanced past the rules of this one.
+        static void build_state(const rules& rules_, const id_type index_,
+            id_type& unique_id_, node_ptr_vector& node_ptr_vector_,
+            internals& internals_, charset_list& charset_list_,
+            std::set<id_type>& used_ids_, const std::size_t threads_,
+            const observer_ptr<build_observer> observer_)
+        {
+            if (rules_.regexes()[index_].empty())
+            {
+                std::ostringstream ss_;
+
+                ss_ << "Lexer states with no rules are not allowed "
+                    "(lexer state " << index_ << ".)";
+                throw runtime_error(ss_.str());
+            }
+
+            // Note that the following variables are per DFA.
+            // Map of regex charset tokens (strings) to index
+            charset_map charset_map_;
+            // Used to fix up $ and \n clashes.
+            id_type cr_id_ = sm_traits::npos();
+            id_type nl_id_ = sm_traits::npos();
+            auto start_ = now(observer_);
+            const std::size_t first_node_ = node_ptr_vector_.size();
+            // Regex syntax tree
+            observer_ptr<node> root_ = build_tree(rules_, index_,
+                node_ptr_vector_, charset_map_, cr_id_, nl_id_, unique_id_);
+            const std::size_t positions_ =
+                number_positions(node_ptr_vector_, first_node_);
+
+            check_zero_len(rules_, root_);
+
+            if (observer_)
+            {
+                observer_->nodes(index_, node_ptr_vector_.size());
+            }
+
+            end_phase(observer_, index_, build_phase::build_tree, start_);
+            build_dfa(charset_map_, root_, positions_, internals_,
+                charset_list_, index_, cr_id_, nl_id_, rules_.flags(),
+                used_ids_, threads_, observer_);
+
+            if (internals_._dfa[index_].size() /
+                internals_._dfa_alphabet[index_] >= sm_traits::npos())
+            {
+                // Overflow
+                throw runtime_error("The id_type you have chosen "
+                    "cannot hold this many DFA rows.");
+            }
+        }
+
         static void build_dfa(const charset_map& charset_map_,
-            const observer_ptr<node> root_, internals& internals_, sm& sm_,
+            const observer_ptr<node> root_, const std::size_t positions_,
+            internals& internals_, charset_list& charset_list_,
             const id_type dfa_index_, id_type& cr_id_, id_type& nl_id_,
-            const std::size_t flags_, std::set<id_type>& used_ids_)
+            const std::size_t flags_, std::set<id_type>& used_ids_,
+            const std::size_t threads_,
+            const observer_ptr<build_observer> observer_)
         {
-            // partitioned charset list
-            charset_list charset_list_;
             // vector mapping token indexes to partitioned token index sets
             index_set_vector set_mapping_;
             auto& dfa_ = internals_._dfa[dfa_index_];
             std::size_t dfa_alphabet_ = 0;
             const node_vector& followpos_ = root_->firstpos();
-            node_set_vector seen_sets_;
-            node_vector_vector seen_vectors_;
-            size_t_vector hash_vector_;
             id_type zero_id_ = sm_traits::npos();
             id_type_set eol_set_;
+            auto start_ = now(observer_);
 
             set_mapping_.resize(charset_map_.size());
             partition_charsets(charset_map_, charset_list_, is_dfa());
@@ -220,7 +396,7 @@ namespace lexertl
                     nl_id_ = *set_mapping_[nl_id_].begin();
                 }
 
-                zero_id_ = sm_traits::compressed ?
+                zero_id_ = compressed::value ?
                     *set_mapping_[charset_map_.find(string_token(0, 0))->
                     second].begin() : sm_traits::npos();
             }
@@ -238,10 +414,63 @@ namespace lexertl
 
             internals_._dfa_alphabet[dfa_index_] =
                 static_cast<id_type>(dfa_alphabet_);
+
+            if (observer_)
+            {
+                observer_->charsets(dfa_index_, charset_map_.size(),
+                    charset_list_.size());
+            }
+
+            end_phase(observer_, dfa_index_, build_phase::partition_charsets,
+                start_);
             // 'jam' state
             dfa_.resize(dfa_alphabet_, 0);
-            closure(followpos_, seen_sets_, seen_vectors_, hash_vector_,
-                static_cast<id_type>(dfa_alphabet_), dfa_, flags_, used_ids_);
+
+            if (threads_ > 1)
+            {
+                build_states_parallel(followpos_, positions_, set_mapping_,
+                    cr_id_, nl_id_, dfa_alphabet_, dfa_, eol_set_, flags_,
+                    used_ids_, threads_);
+            }
+            else
+            {
+                build_states(followpos_, positions_, set_mapping_, cr_id_,
+                    nl_id_, dfa_alphabet_, dfa_, eol_set_, flags_, used_ids_,
+                    dfa_index_, observer_);
+            }
+
+            end_phase(observer_, dfa_index_, build_phase::closure, start_);
+            fix_clashes(eol_set_, cr_id_, nl_id_, zero_id_, dfa_, dfa_alphabet_,
+                compressed());
+            end_phase(observer_, dfa_index_, build_phase::fix_clashes, start_);
+        }
+
+        // Subset construction: finds every DFA state reachable from the
+        // start state (followpos_) and fills in its row of dfa_. States
+        // are numbered in the order they are first reached, processing
+        // states in order and their transitions in equiv list order.
+        static void build_states(const node_vector& followpos_,
+            const std::size_t positions_,
+            const index_set_vector& set_mapping_, const id_type cr_id_,
+            const id_type nl_id_, const std::size_t dfa_alphabet_,
+            id_type_vector& dfa_, id_type_set& eol_set_,
+            const std::size_t flags_, std::set<id_type>& used_ids_,
+            const id_type dfa_index_,
+            const observer_ptr<build_observer> observer_)
+        {
+            // Scratch space for closure() and build_equiv_list(), indexed
+            // by node position
+            std::vector<bool> marked_(positions_, false);
+            node_set_vector seen_sets_;
+            node_vector_vector seen_vectors_;
+            size_t_vector hash_vector_;
+            // Open addressing index into hash_vector_ (index + 1, 0 if
+            // the slot is free)
+            size_t_vector hash_index_;
+
+            closure(followpos_, marked_, seen_sets_, seen_vectors_,
+                hash_vector_, hash_index_, static_cast<id_type>(dfa_alphabet_),
+                dfa_, flags_, used_ids_);
 
             // Loop over states
             for (id_type index_ = 0; index_ < static_cast<id_type>
@@ -250,7 +479,7 @@ namespace lexertl
                 equivset_list equiv_list_;
 
                 // Intersect charsets
-                build_equiv_list(*seen_vectors_[index_], set_mapping_,
+                build_equiv_list(*seen_vectors_[index_], set_mapping_, marked_,
                     equiv_list_, is_dfa());
 
                 for (auto& equivset_ : equiv_list_)
@@ -259,8 +488,8 @@ namespace lexertl
                         set_mapping_);
 
                     const id_type transition_ =
-                        closure(equivset_->_followpos, seen_sets_,
-                            seen_vectors_, hash_vector_,
+                        closure(equivset_->_followpos, marked_, seen_sets_,
+                            seen_vectors_, hash_vector_, hash_index_,
                             static_cast<id_type>(dfa_alphabet_), dfa_, flags_,
                             used_ids_);
 
@@ -276,16 +505,321 @@ namespace lexertl
                         if (!(*ptr_ && !(*ptr_ & *state_bit::greedy) &&
                             equivset_->_greedy == greedy_repeat::no))
                         {
-                            set_transitions(transition_, equivset_.get(), dfa_,
-                                ptr_, index_, eol_set_);
+                            set_transitions(transition_, equivset_.get(),
+                                dfa_.front(), ptr_, index_, eol_set_);
                         }
                     }
                 }
+
+                if (observer_)
+                {
+                    observer_->states(dfa_index_,
+                        static_cast<std::size_t>(index_) + 1,
+                        seen_vectors_.size());
+                }
             }
+        }
 
-            fix_clashes(eol_set_, cr_id_, nl_id_, zero_id_, dfa_, dfa_alphabet_,
-                compressed());
-            append_dfa(charset_list_, internals_, sm_, dfa_index_, lookup());
+        // A DFA state found by build_states_parallel(). Transitions hold
+        // the index of the target in the order states happened to be
+        // found, until the states are renumbered at the end.
+        struct dfa_state
+        {
+            node_vector _nodes;
+            id_type_vector _row;
+            // Every state closure() led to, in equiv list order (which
+            // includes states reached by pruned transitions).
+            id_type_vector _targets;
+            id_type _bol = 0;
+        };
+
+        // As build_states(), but states are processed by threads_ threads
+        // taking them from a shared worklist. New states are registered in
+        // the same hash index as build_states() uses, under a mutex. The
+        // states are then renumbered by replaying the serial order of
+        // discovery over the recorded targets, so dfa_ ends up identical
+        // to what build_states() gives.
+        static void build_states_parallel(const node_vector& followpos_,
+            const std::size_t positions_,
+            const index_set_vector& set_mapping_, const id_type cr_id_,
+            const id_type nl_id_, const std::size_t dfa_alphabet_,
+            id_type_vector& dfa_, id_type_set& eol_set_,
+            const std::size_t flags_, std::set<id_type>& used_ids_,
+            const std::size_t threads_)
+        {
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            node_set_vector seen_sets_;
+            size_t_vector hash_vector_;
+            size_t_vector hash_index_;
+            std::vector<std::unique_ptr<dfa_state>> states_;
+            // States whose transitions are yet to be found
+            id_type_vector worklist_;
+            std::size_t busy_ = 0;
+            std::exception_ptr error_;
+            id_type_set found_eol_set_;
+            std::vector<std::future<void>> futures_;
+            id_type_vector number_;
+            id_type_vector order_;
+
+            // Returns the state with node set set_, adding it (and
+            // queuing it) if it is new. mutex_ must be held.
+            auto add_state_ = [&](node_set& set_, node_vector& vector_,
+                const std::size_t hash_, const state_header& header_)
+            {
+                id_type index_ = find_state(hash_, set_, seen_sets_,
+                    hash_vector_, hash_index_);
+
+                if (index_ == 0)
+                {
+                    // The same limit build() checks once the DFA is
+                    // complete (row 0 is the dead state), caught here
+                    // before the new state's index can wrap.
+                    if (seen_sets_.size() + 2 >= sm_traits::npos())
+                    {
+                        // Overflow
+                        throw runtime_error("The id_type you have chosen "
+                            "cannot hold this many DFA rows.");
+                    }
+
+                    auto state_ = std::make_unique<dfa_state>();
+
+                    state_->_nodes = std::move(vector_);
+                    state_->_row.resize(dfa_alphabet_, 0);
+                    std::copy(header_.cbegin(), header_.cend(),
+                        state_->_row.begin());
+                    states_.push_back(std::move(state_));
+                    seen_sets_.push_back(std::move(set_));
+                    hash_vector_.push_back(hash_);
+                    index_state(hash_vector_, hash_index_);
+                    index_ = static_cast<id_type>(seen_sets_.size());
+                    worklist_.push_back(index_);
+                    cv_.notify_one();
+                }
+
+                return index_;
+            };
+
+            auto worker_ = [&]()
+            {
+                std::vector<bool> marked_(positions_, false);
+                std::set<id_type> used_ids_local_;
+                id_type_set eol_set_local_;
+                std::vector<node_set> sets_;
+                std::vector<node_vector> vectors_;
+                std::vector<std::size_t> hashes_;
+                std::vector<state_header> headers_;
+                std::unique_lock<std::mutex> lock_(mutex_);
+
+                try
+                {
+                    for (;;)
+                    {
+                        cv_.wait(lock_, [&]()
+                        {
+                            return !worklist_.empty() || busy_ == 0 ||
+                                error_;
+                        });
+
+                        if (worklist_.empty() || error_)
+                            break;
+
+                        const id_type index_ = worklist_.back();
+                        dfa_state& state_ = *states_[index_ - 1];
+                        equivset_list equiv_list_;
+
+                        worklist_.pop_back();
+                        ++busy_;
+                        lock_.unlock();
+                        build_equiv_list(state_._nodes, set_mapping_,
+                            marked_, equiv_list_, is_dfa());
+                        sets_.clear();
+                        vectors_.clear();
+                        hashes_.clear();
+                        headers_.clear();
+
+                        // Work out every target before taking the lock
+                        for (auto& equivset_ : equiv_list_)
+                        {
+                            prune_eol_clashes(equivset_->_followpos, cr_id_,
+                                nl_id_, set_mapping_);
+                            sets_.emplace_back();
+                            vectors_.emplace_back();
+                            hashes_.push_back(0);
+                            headers_.emplace_back();
+
+                            if (!equivset_->_followpos.empty())
+                            {
+                                closure_set(equivset_->_followpos, marked_,
+                                    sets_.back(), vectors_.back(),
+                                    hashes_.back(), headers_.back(), flags_,
+                                    used_ids_local_);
+                            }
+                        }
+
+                        lock_.lock();
+
+                        for (std::size_t i_ = 0, size_ = sets_.size();
+                            i_ < size_; ++i_)
+                        {
+                            // An empty set means no transition
+                            state_._targets.push_back(sets_[i_].empty() ?
+                                sm_traits::npos() : add_state_(sets_[i_],
+                                    vectors_[i_], hashes_[i_], headers_[i_]));
+                        }
+
+                        lock_.unlock();
+
+                        auto target_iter_ = state_._targets.cbegin();
+
+                        for (auto& equivset_ : equiv_list_)
+                        {
+                            const id_type transition_ = *target_iter_++;
+
+                            if (transition_ != sm_traits::npos())
+                            {
+                                observer_ptr<id_type> ptr_ =
+                                    &state_._row.front();
+
+                                // Prune abstemious transitions from end
+                                // states.
+                                if (!(*ptr_ && !(*ptr_ & *state_bit::greedy) &&
+                                    equivset_->_greedy == greedy_repeat::no))
+                                {
+                                    set_transitions(transition_,
+                                        equivset_.get(), state_._bol, ptr_,
+                                        index_ - 1, eol_set_local_);
+                                }
+                            }
+                        }
+
+                        lock_.lock();
+                        --busy_;
+
+                        if (worklist_.empty() && busy_ == 0)
+                            cv_.notify_all();
+                    }
+                }
+                catch (...)
+                {
+                    if (!lock_.owns_lock())
+                        lock_.lock();
+
+                    if (!error_)
+                        error_ = std::current_exception();
+
+                    cv_.notify_all();
+                }
+
+                used_ids_.insert(used_ids_local_.cbegin(),
+                    used_ids_local_.cend());
+                found_eol_set_.insert(eol_set_local_.cbegin(),
+                    eol_set_local_.cend());
+            };
+
+            {
+                node_set set_;
+                node_vector vector_;
+                std::size_t hash_ = 0;
+                state_header header_;
+                std::vector<bool> marked_(positions_, false);
+
+                if (followpos_.empty())
+                    return;
+
+                closure_set(followpos_, marked_, set_, vector_, hash_,
+                    header_, flags_, used_ids_);
+
+                std::lock_guard<std::mutex> guard_(mutex_);
+
+                add_state_(set_, vector_, hash_, header_);
+            }
+
+            for (std::size_t i_ = 1; i_ < threads_; ++i_)
+            {
+                futures_.push_back(std::async(std::launch::async, worker_));
+            }
+
+            worker_();
+
+            for (auto& future_ : futures_)
+            {
+                future_.get();
+            }
+
+            if (error_)
+                std::rethrow_exception(error_);
+
+            // Number the states as build_states() would have found them
+            number_.resize(states_.size() + 1, 0);
+            number_[1] = 1;
+            order_.push_back(1);
+
+            for (std::size_t i_ = 0; i_ < order_.size(); ++i_)
+            {
+                for (const id_type target_ : states_[order_[i_] - 1]->_targets)
+                {
+                    if (target_ != sm_traits::npos() && number_[target_] == 0)
+                    {
+                        order_.push_back(target_);
+                        number_[target_] =
+                            static_cast<id_type>(order_.size());
+                    }
+                }
+            }
+
+            dfa_.reserve(dfa_alphabet_ * (order_.size() + 1));
+
+            for (const id_type index_ : order_)
+            {
+                const dfa_state& state_ = *states_[index_ - 1];
+                const std::size_t old_size_ = dfa_.size();
+
+                dfa_.insert(dfa_.end(), state_._row.cbegin(),
+                    state_._row.cend());
+
+                observer_ptr<id_type> ptr_ = &dfa_[old_size_];
+
+                ptr_[*state_index::eol] = number_[ptr_[*state_index::eol]];
+
+                for (std::size_t i_ = *state_index::transitions;
+                    i_ < dfa_alphabet_; ++i_)
+                {
+                    ptr_[i_] = number_[ptr_[i_]];
+                }
+
+                if (state_._bol)
+                {
+                    dfa_.front() = number_[state_._bol];
+                }
+            }
+
+            for (const id_type index_ : found_eol_set_)
+            {
+                eol_set_.insert(number_[index_]);
+            }
+        }
+
+        // Only read the clock when somebody is watching.
+        static std::chrono::steady_clock::time_point now
+            (const observer_ptr<build_observer> observer_)
+        {
+            return observer_ ? std::chrono::steady_clock::now() :
+                std::chrono::steady_clock::time_point();
+        }
+
+        // Reports the time since start_ as phase_ and restarts the clock.
+        static void end_phase(const observer_ptr<build_observer> observer_,
+            const id_type dfa_, const build_phase phase_,
+            std::chrono::steady_clock::time_point& start_)
+        {
+            if (observer_)
+            {
+                const auto end_ = std::chrono::steady_clock::now();
+
+                observer_->phase(dfa_, phase_, end_ - start_);
+                start_ = end_;
+            }
         }
 
         // Removing clashes will cause an error about rules that cannot match,
@@ -517,15 +1051,16 @@ namespace lexertl
             }
         }
 
+        // bol_ is where the start state for the beginning of a line goes.
         static void set_transitions(const id_type transition_,
-            equivset* equivset_, typename internals::id_type_vector& dfa_,
-            id_type* ptr_, const id_type index_, id_type_set& eol_set_)
+            equivset* equivset_, id_type& bol_, id_type* ptr_,
+            const id_type index_, id_type_set& eol_set_)
         {
             for (id_type i_ : equivset_->_index_vector)
             {
                 if (i_ == parser::bol_token())
                 {
-                    dfa_.front() = transition_;
+                    bol_ = transition_;
                 }
                 else if (i_ == parser::eol_token())
                 {
@@ -772,66 +1307,94 @@ namespace lexertl
         }
 
         // DFA version
+        // Sweeps over the sorted range boundaries of every charset, so
+        // that each elementary interval between two boundaries is seen
+        // once along with the charsets that contain it. The intervals
+        // contained by the same charsets make up one partition, and
+        // partitions are ordered by their first character.
         static void partition_charsets(const charset_map& map_,
             charset_list& lhs_, const std::true_type&)
         {
-            charset_list rhs_;
+            // (character, charset index) where a range starts, or one
+            // past where it ends
+            using boundary = std::pair<std::size_t, id_type>;
+            using boundary_vector = std::vector<boundary>;
+            using range = typename charset::token::range;
+            boundary_vector starts_;
+            boundary_vector ends_;
+            index_set active_;
+            std::map<id_type_vector, observer_ptr<charset>> partitions_;
+
+            for (const auto& pair_ : map_)
+            {
+                for (const auto& range_ : pair_.first._ranges)
+                {
+                    starts_.emplace_back(static_cast<std::size_t>
+                        (range_.first), pair_.second);
+                    ends_.emplace_back(static_cast<std::size_t>
+                        (range_.second) + 1, pair_.second);
+                }
+            }
 
-            fill_rhs_list(map_, rhs_);
+            std::sort(starts_.begin(), starts_.end());
+            std::sort(ends_.begin(), ends_.end());
 
-            if (!rhs_.empty())
+            auto start_iter_ = starts_.cbegin();
+            const auto start_end_ = starts_.cend();
+            auto end_iter_ = ends_.cbegin();
+            const auto end_end_ = ends_.cend();
+            // Every range ends after it starts, so there is always an end
+            // left while anything is active.
+            const auto next_ = [&]()
             {
-                typename charset_list::iterator iter_;
-                typename charset_list::iterator end_;
-                charset_ptr overlap_ = std::make_unique<charset>();
+                return start_iter_ == start_end_ ? end_iter_->first :
+                    std::min(start_iter_->first, end_iter_->first);
+            };
 
-                lhs_.push_back(std::move(rhs_.front()));
-                rhs_.pop_front();
+            while (end_iter_ != end_end_)
+            {
+                const std::size_t first_ = next_();
 
-                while (!rhs_.empty())
+                for (; end_iter_ != end_end_ && end_iter_->first == first_;
+                    ++end_iter_)
                 {
-                    charset_ptr r_(rhs_.front().release());
+                    active_.erase(end_iter_->second);
+                }
 
-                    rhs_.pop_front();
-                    iter_ = lhs_.begin();
-                    end_ = lhs_.end();
+                for (; start_iter_ != start_end_ &&
+                    start_iter_->first == first_; ++start_iter_)
+                {
+                    active_.insert(start_iter_->second);
+                }
 
-                    while (!r_->empty() && iter_ != end_)
-                    {
-                        auto l_iter_ = iter_;
+                if (active_.empty())
+                    continue;
 
-                        (*l_iter_)->intersect(*r_.get(), *overlap_.get());
+                const std::size_t last_ = next_() - 1;
+                observer_ptr<charset>& charset_ = partitions_
+                    [id_type_vector(active_.cbegin(), active_.cend())];
 
-                        if (overlap_->empty())
-                        {
-                            ++iter_;
-                        }
-                        else if ((*l_iter_)->empty())
-                        {
-                            l_iter_->reset(overlap_.release());
-                            overlap_ = std::make_unique<charset>();
-                            ++iter_;
-                        }
-                        else if (r_->empty())
-                        {
-                            r_.reset(overlap_.release());
-                            overlap_ = std::make_unique<charset>();
-                            break;
-                        }
-                        else
-                        {
-                            iter_ = lhs_.insert(++iter_, charset_ptr());
-                            iter_->reset(overlap_.release());
-                            overlap_ = std::make_unique<charset>();
-                            ++iter_;
-                            end_ = lhs_.end();
-                        }
-                    }
+                if (!charset_)
+                {
+                    lhs_.push_back(std::make_unique<charset>());
+                    charset_ = lhs_.back().get();
+                    charset_->_index_set = active_;
+                }
 
-                    if (!r_->empty())
-                    {
-                        lhs_.push_back(std::move(r_));
-                    }
+                auto& ranges_ = charset_->_token._ranges;
+
+                if (!ranges_.empty() &&
+                    static_cast<std::size_t>(ranges_.back().second) + 1 ==
+                    first_)
+                {
+                    ranges_.back().second =
+                        static_cast<typename range::second_type>(last_);
+                }
+                else
+                {
+                    ranges_.emplace_back(static_cast<typename range::
+                        first_type>(first_), static_cast<typename range::
+                        second_type>(last_));
                 }
             }
         }
@@ -851,12 +1414,22 @@ namespace lexertl
         {
             auto iter_ = charset_list_.cbegin();
             auto end_ = charset_list_.cend();
+            id_type_vector& lookup_ = internals_._lookup[dfa_index_];
+            // Class of every character when paged
+            id_type_vector classes_;
+
+            if (paged::value)
+            {
+                classes_.resize(static_cast<std::size_t>
+                    (char_traits::max_val()) + 1,
+                    static_cast<id_type>(*state_index::dead_state));
+            }
 
             for (id_type index_ = 0; iter_ != end_; ++iter_, ++index_)
             {
                 observer_ptr<const charset> cs_ = iter_->get();
 
-                fill_lookup(cs_->_token, &internals_._lookup[dfa_index_],
+                fill_lookup(cs_->_token, paged::value ? &classes_ : &lookup_,
                     index_, lookup());
 
                 for (const id_type i_ : cs_->_index_set)
@@ -864,6 +1437,61 @@ namespace lexertl
                     set_mapping_[i_].insert(index_);
                 }
             }
+
+            build_pages(classes_, lookup_, paged());
+        }
+
+        static void build_pages(const id_type_vector&, id_type_vector&,
+            const std::false_type&)
+        {
+            // Do nothing
+        }
+
+        // Lay out classes_ as a paged lookup table (see paged_lookup).
+        static void build_pages(const id_type_vector& classes_,
+            id_type_vector& lookup_, const std::true_type&)
+        {
+            const std::size_t page_ = detail::paged_lookup::page;
+            std::map<id_type_vector, id_type> slots_;
+
+            lookup_.assign(classes_.cbegin(), classes_.cbegin() + page_);
+            lookup_.resize(page_ + detail::paged_lookup::pages, 0);
+            slots_.emplace(id_type_vector(lookup_.cbegin(),
+                lookup_.cbegin() + page_), 0);
+
+            for (std::size_t p_ = 1; p_ < detail::paged_lookup::pages; ++p_)
+            {
+                const std::size_t first_ = p_ * page_;
+                id_type_vector chars_(page_,
+                    static_cast<id_type>(*state_index::dead_state));
+
+                if (first_ < classes_.size())
+                {
+                    std::copy(classes_.cbegin() + first_, classes_.cbegin() +
+                        std::min(first_ + page_, classes_.size()),
+                        chars_.begin());
+                }
+
+                auto pair_ = slots_.emplace(std::move(chars_),
+                    static_cast<id_type>(lookup_.size() / page_));
+
+                if (pair_.second)
+                {
+                    if (lookup_.size() / page_ >=
+                        static_cast<std::size_t>(sm_traits::npos()) - 1)
+                    {
+                        // Overflow
+                        throw runtime_error("The id_type you have chosen "
+                            "cannot hold this many lookup pages.");
+                    }
+
+                    lookup_.insert(lookup_.end(), pair_.first->first.cbegin(),
+                        pair_.first->first.cend());
+                }
+
+                lookup_[detail::paged_lookup::index + p_] =
+                    pair_.first->second;
+            }
         }
 
         // char_state_machine version
@@ -898,10 +1526,52 @@ namespace lexertl
         }
 
         static id_type closure(const node_vector& followpos_,
-            node_set_vector& seen_sets_, node_vector_vector& seen_vectors_,
-            size_t_vector& hash_vector_, const id_type size_,
+            std::vector<bool>& marked_, node_set_vector& seen_sets_,
+            node_vector_vector& seen_vectors_, size_t_vector& hash_vector_,
+            size_t_vector& hash_index_, const id_type size_,
             id_type_vector& dfa_, const std::size_t flags_,
             std::set<id_type>& used_ids_)
+        {
+            if (followpos_.empty()) return sm_traits::npos();
+
+            id_type index_ = 0;
+            node_set set_;
+            std::unique_ptr<node_vector> vector_ptr_ =
+                std::make_unique<node_vector>();
+            std::size_t hash_ = 0;
+            state_header header_;
+
+            closure_set(followpos_, marked_, set_, *vector_ptr_, hash_,
+                header_, flags_, used_ids_);
+            index_ = find_state(hash_, set_, seen_sets_, hash_vector_,
+                hash_index_);
+
+            if (index_ == 0)
+            {
+                seen_sets_.push_back(std::move(set_));
+                seen_vectors_.push_back(std::move(vector_ptr_));
+                hash_vector_.push_back(hash_);
+                index_state(hash_vector_, hash_index_);
+                // State 0 is the jam state...
+                index_ = static_cast<id_type>(seen_sets_.size());
+
+                const std::size_t old_size_ = dfa_.size();
+
+                dfa_.resize(old_size_ + size_, 0);
+                std::copy(header_.cbegin(), header_.cend(),
+                    dfa_.begin() + old_size_);
+            }
+
+            return index_;
+        }
+
+        // Works out the node set (set_), node vector (vector_) and hash of
+        // the DFA state reached by followpos_, along with the start of
+        // its row. followpos_ must not be empty.
+        static void closure_set(const node_vector& followpos_,
+            std::vector<bool>& marked_, node_set& set_, node_vector& vector_,
+            std::size_t& hash_, state_header& header_,
+            const std::size_t flags_, std::set<id_type>& used_ids_)
         {
             bool end_state_ = false;
             id_type id_ = 0;
@@ -909,75 +1579,133 @@ namespace lexertl
             id_type next_dfa_ = 0;
             id_type push_dfa_ = sm_traits::npos();
             bool pop_dfa_ = false;
-            std::size_t hash_ = 0;
             greedy_repeat greedy_ = greedy_repeat::yes;
 
-            if (followpos_.empty()) return sm_traits::npos();
+            for (observer_ptr<node> node_ : followpos_)
+            {
+                const std::size_t position_ = node_->position();
 
-            id_type index_ = 0;
-            std::unique_ptr<node_set> set_ptr_ = std::make_unique<node_set>();
-            std::unique_ptr<node_vector> vector_ptr_ =
-                std::make_unique<node_vector>();
+                if (!marked_[position_])
+                {
+                    marked_[position_] = true;
+                    set_.push_back(position_);
+                    vector_.push_back(node_);
+                    closure_ex(node_, end_state_, id_, user_id_, next_dfa_,
+                        push_dfa_, pop_dfa_, greedy_, flags_, used_ids_);
+                }
+            }
 
-            for (observer_ptr<node> node_ : followpos_)
+            for (const std::size_t position_ : set_)
             {
-                closure_ex(node_, end_state_, id_, user_id_, next_dfa_,
-                    push_dfa_, pop_dfa_, *set_ptr_, *vector_ptr_, hash_,
-                    greedy_, flags_, used_ids_);
+                marked_[position_] = false;
+                hash_ += hash_position(position_);
             }
 
-            bool found_ = false;
-            auto hash_iter_ = hash_vector_.cbegin();
-            auto hash_end_ = hash_vector_.cend();
-            auto set_iter_ = seen_sets_.cbegin();
+            std::sort(set_.begin(), set_.end());
+            header_.fill(0);
 
-            for (; !found_ && hash_iter_ != hash_end_;
-                ++hash_iter_, ++set_iter_)
+            if (end_state_)
             {
-                found_ = *hash_iter_ == hash_ && *(*set_iter_) == *set_ptr_;
-                ++index_;
+                header_[*state_index::end_state] = *state_bit::end_state;
+
+                if (greedy_ != greedy_repeat::no)
+                    header_[*state_index::end_state] |= *state_bit::greedy;
+
+                if (pop_dfa_)
+                {
+                    header_[*state_index::end_state] |= *state_bit::pop_dfa;
+                }
+
+                header_[*state_index::id] = id_;
+                header_[*state_index::user_id] = user_id_;
+                header_[*state_index::push_dfa] = push_dfa_;
+                header_[*state_index::next_dfa] = next_dfa_;
             }
+        }
 
-            if (!found_)
-            {
-                seen_sets_.push_back(std::move(set_ptr_));
-                seen_vectors_.push_back(std::move(vector_ptr_));
-                hash_vector_.push_back(hash_);
-                // State 0 is the jam state...
-                index_ = static_cast<id_type>(seen_sets_.size());
+        // Returns the (1 based) index of the state with node set set_, or
+        // 0 if there is no such state yet.
+        static id_type find_state(const std::size_t hash_,
+            const node_set& set_, const node_set_vector& seen_sets_,
+            const size_t_vector& hash_vector_,
+            const size_t_vector& hash_index_)
+        {
+            if (hash_index_.empty())
+                return 0;
 
-                const std::size_t old_size_ = dfa_.size();
+            const std::size_t mask_ = hash_index_.size() - 1;
 
-                dfa_.resize(old_size_ + size_, 0);
+            for (std::size_t slot_ = hash_ & mask_; hash_index_[slot_];
+                slot_ = (slot_ + 1) & mask_)
+            {
+                const std::size_t index_ = hash_index_[slot_];
 
-                if (end_state_)
+                if (hash_vector_[index_ - 1] == hash_ &&
+                    seen_sets_[index_ - 1] == set_)
                 {
-                    dfa_[old_size_] |= *state_bit::end_state;
+                    return static_cast<id_type>(index_);
+                }
+            }
 
-                    if (greedy_ != greedy_repeat::no)
-                        dfa_[old_size_] |= *state_bit::greedy;
+            return 0;
+        }
 
-                    if (pop_dfa_)
-                    {
-                        dfa_[old_size_] |= *state_bit::pop_dfa;
-                    }
+        // Adds the last entry of hash_vector_ to hash_index_, doubling
+        // the index (and rehashing) to keep it at most half full.
+        static void index_state(const size_t_vector& hash_vector_,
+            size_t_vector& hash_index_)
+        {
+            const std::size_t size_ = hash_vector_.size();
 
-                    dfa_[old_size_ + *state_index::id] = id_;
-                    dfa_[old_size_ + *state_index::user_id] = user_id_;
-                    dfa_[old_size_ + *state_index::push_dfa] = push_dfa_;
-                    dfa_[old_size_ + *state_index::next_dfa] = next_dfa_;
+            if (size_ * 2 > hash_index_.size())
+            {
+                hash_index_.assign(std::max(hash_index_.size() * 2,
+                    static_cast<std::size_t>(64)), 0);
+
+                for (std::size_t index_ = 1; index_ <= size_; ++index_)
+                {
+                    insert_slot(hash_vector_, index_, hash_index_);
                 }
             }
+            else
+            {
+                insert_slot(hash_vector_, size_, hash_index_);
+            }
+        }
 
-            return index_;
+        static void insert_slot(const size_t_vector& hash_vector_,
+            const std::size_t index_, size_t_vector& hash_index_)
+        {
+            const std::size_t mask_ = hash_index_.size() - 1;
+            std::size_t slot_ = hash_vector_[index_ - 1] & mask_;
+
+            while (hash_index_[slot_])
+            {
+                slot_ = (slot_ + 1) & mask_;
+            }
+
+            hash_index_[slot_] = index_;
+        }
+
+        // The hash of a node set is the sum of the hashes of its node
+        // positions, so does not depend on the order they were added in.
+        // Each position is hashed with the MurmurHash3 64 bit finaliser.
+        static std::size_t hash_position(const std::size_t position_)
+        {
+            auto key_ = static_cast<std::uint64_t>(position_);
+
+            key_ ^= key_ >> 33;
+            key_ *= 0xff51afd7ed558ccdULL;
+            key_ ^= key_ >> 33;
+            key_ *= 0xc4ceb9fe1a85ec53ULL;
+            key_ ^= key_ >> 33;
+            return static_cast<std::size_t>(key_);
         }
 
         static void closure_ex(observer_ptr<node> node_, bool& end_state_,
             id_type& id_, id_type& user_id_, id_type& next_dfa_,
-            id_type& push_dfa_, bool& pop_dfa_, node_set& set_ptr_,
-            node_vector& vector_ptr_, std::size_t& hash_,
-            greedy_repeat& greedy_, const std::size_t flags_,
-            std::set<id_type>& used_ids_)
+            id_type& push_dfa_, bool& pop_dfa_, greedy_repeat& greedy_,
+            const std::size_t flags_, std::set<id_type>& used_ids_)
         {
             if (node_->end_state())
             {
@@ -995,17 +1723,12 @@ namespace lexertl
                         used_ids_.insert(node_->unique_id());
                 }
             }
-
-            if (set_ptr_.insert(node_).second)
-            {
-                vector_ptr_.push_back(node_);
-                hash_ += reinterpret_cast<std::size_t>(node_);
-            }
         }
 
         // NFA version
         static void build_equiv_list(const node_vector& vector_,
-            const index_set_vector& set_mapping_, equivset_list& lhs_,
+            const index_set_vector& set_mapping_,
+            std::vector<bool>& /*marked_*/, equivset_list& lhs_,
             const std::false_type&)
         {
             fill_rhs_list(vector_, set_mapping_, lhs_);
@@ -1013,8 +1736,8 @@ namespace lexertl
 
         // DFA version
         static void build_equiv_list(const node_vector& vector_,
-            const index_set_vector& set_mapping_, equivset_list& lhs_,
-            const std::true_type&)
+            const index_set_vector& set_mapping_, std::vector<bool>& marked_,
+            equivset_list& lhs_, const std::true_type&)
         {
             equivset_list rhs_;
 
@@ -1041,7 +1764,8 @@ namespace lexertl
                     {
                         auto l_iter_ = iter_;
 
-                        (*l_iter_)->intersect(*r_.get(), *overlap_.get());
+                        (*l_iter_)->intersect(*r_.get(), *overlap_.get(),
+                            marked_);
 
                         if (overlap_->empty())
                         {
@@ -1116,6 +1840,28 @@ namespace lexertl
     using char_generator = basic_generator<rules, char_state_machine>;
     using wchar_generator = basic_generator<wrules, wchar_state_machine>;
     using u32char_generator = basic_generator<u32rules, u32char_state_machine>;
+
+    // Builds a wide character state_machine that classifies each code
+    // point with a single table lookup (see detail::paged_lookup) rather
+    // than the three lookups that compressed tables need.
+    template<typename rules, typename sm>
+    using basic_paged_generator = basic_generator<rules, sm,
+        basic_char_traits<typename sm::traits::input_char_type>,
+        basic_paged_sm_traits<typename rules::char_type,
+        typename sm::id_type>>;
+    using wpaged_generator = basic_paged_generator<wrules, wstate_machine>;
+    using u32paged_generator =
+        basic_paged_generator<u32rules, u32state_machine>;
+
+    // Builds a byte state_machine that lexes UTF-8 input directly (one
+    // table lookup per byte, no decoding) from rules over code points.
+    // Each charset is compiled to the UTF-8 byte sequences that encode it.
+    // Note that unmatched input is skipped a byte at a time.
+    template<typename rules, typename sm>
+    using basic_utf8_generator = basic_generator<rules, sm,
+        basic_char_traits<typename sm::traits::input_char_type>,
+        basic_utf8_sm_traits<typename rules::char_type, typename sm::id_type>>;
+    using utf8_generator = basic_utf8_generator<u32rules, state_machine>;
 }
 
 #endif
@@ -15,6 +15,23 @@ namespace lexertl
 {
     namespace detail
     {
+        // A paged lookup table classifies every code point with a single
+        // table lookup. It is laid out as:
+        //
+        // [page 0][page index][page]...
+        //
+        // Page 0 holds the classes of code points 0 - 255 and is indexed
+        // directly. Entry n of the page index holds the slot (in units of
+        // a page) of the page for code points n * 256 to n * 256 + 255.
+        // Identical pages are shared.
+        struct paged_lookup
+        {
+            enum
+            {
+                page = 256, index = page, pages = 0x1100, max_char = 0x10ffff
+            };
+        };
+
         template<typename id_type>
         struct basic_internals
         {
@@ -41,6 +58,14 @@ namespace lexertl
                 return _dfa.empty();
             }
 
+            // True if the lookup tables classify wide characters directly
+            // (see paged_lookup).
+            bool paged() const
+            {
+                return !_lookup.empty() &&
+                    _lookup.front().size() > paged_lookup::page;
+            }
+
             void add_states(const std::size_t num_)
             {
                 for (std::size_t index_ = 0; index_ < num_; ++index_)
@@ -53,6 +78,23 @@ namespace lexertl
                 }
             }
 
+            template<typename entry_type = id_type>
+            const entry_type* lookup(const std::size_t dfa_) const
+            {
+                return &_lookup[dfa_].front();
+            }
+
+            id_type dfa_alphabet(const std::size_t dfa_) const
+            {
+                return _dfa_alphabet[dfa_];
+            }
+
+            template<typename entry_type = id_type>
+            const entry_type* dfa(const std::size_t dfa_) const
+            {
+                return &_dfa[dfa_].front();
+            }
+
             void swap(basic_internals& internals_) noexcept
             {
                 std::swap(_eoi, internals_._eoi);
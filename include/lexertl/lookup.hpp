@@ -7,13 +7,16 @@
 #define LEXERTL_LOOKUP_HPP
 
 #include "enums.hpp"
+#include "flat_internals.hpp"
 #include "match_results.hpp"
 #include "runtime_error.hpp"
 
 #include <array>
 #include <cassert>
 #include <iterator>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace lexertl
 {
@@ -73,7 +76,8 @@ namespace lexertl
         template<typename id_type, bool>
         struct recursive_state
         {
-            explicit recursive_state(const id_type*)
+            template<typename entry_type>
+            explicit recursive_state(const entry_type*)
             {
             }
         };
@@ -84,21 +88,113 @@ namespace lexertl
             bool _pop;
             id_type _push_dfa;
 
-            explicit recursive_state(const id_type* ptr_) :
+            template<typename entry_type>
+            explicit recursive_state(const entry_type* ptr_) :
                 _pop((*ptr_& *state_bit::pop_dfa) != 0),
-                _push_dfa(*(ptr_ + *state_index::push_dfa))
+                _push_dfa(widen<id_type>(*(ptr_ + *state_index::push_dfa)))
             {
             }
         };
 
+        template<typename id_type, bool>
+        struct accel_tables
+        {
+            template<typename internals>
+            accel_tables(const internals&, const id_type)
+            {
+            }
+        };
+
+        template<typename id_type>
+        struct accel_tables<id_type, true>
+        {
+            const unsigned char* _bits;
+            const accel_state* _rows;
+
+            accel_tables(const basic_flat_internals<id_type>& internals_,
+                const id_type state_) :
+                _bits(&internals_._accel_bits[internals_._accel_bit[state_]]),
+                _rows(&internals_._accel[internals_._accel_row[state_]])
+            {
+            }
+        };
+
+        template<typename id_type, bool>
+        struct profile_state
+        {
+            template<typename results>
+            profile_state(const results&, const id_type)
+            {
+            }
+        };
+
+        template<typename id_type>
+        struct profile_state<id_type, true>
+        {
+            basic_profile<id_type>* _profile;
+            id_type _dfa;
+            // Characters read by this walk and how many of those the
+            // longest match so far covers
+            std::size_t _examined = 0;
+            std::size_t _consumed = 0;
+
+            template<typename results>
+            profile_state(const results& results_, const id_type state_) :
+                _profile(results_.profile),
+                _dfa(state_)
+            {
+                if (_profile)
+                {
+                    _profile->start(state_);
+                }
+            }
+        };
+
+        template<typename results>
+        void inc_end(results&, const std::false_type&)
+        {
+            // Do nothing
+        }
+
+        template<typename results>
+        void inc_end(results& results_, const std::true_type&)
+        {
+            ++results_.second;
+        }
+
+        // Pointers into contiguous input get their own lookup kernel.
+        struct contiguous_iterator_tag : std::random_access_iterator_tag
+        {
+        };
+
+        template<typename iter_type>
+        using iterator_tag = typename std::conditional
+            <std::is_pointer<iter_type>::value, contiguous_iterator_tag,
+            typename std::iterator_traits<iter_type>::iterator_category>::type;
+
+        // Wide characters classified by a paged lookup table (as opposed
+        // to being sliced into bytes).
+        struct paged_type : std::true_type
+        {
+        };
+
+        // How a token ended once the DFA walk for it has stopped.
+        enum class token_end
+        {
+            done, skip, again
+        };
+
         template<typename internals, typename id_type, typename index_type,
-            std::size_t flags>
+            std::size_t flags, typename entry_type = id_type,
+            bool row_offsets = false, bool accel = false>
         struct lookup_state
         {
-            const id_type* _lookup;
+            const entry_type* _lookup;
             id_type _dfa_alphabet;
-            const id_type* _dfa;
-            const id_type* _ptr;
+            const entry_type* _dfa;
+            const entry_type* _ptr;
+            // The last accepting row seen, when decoded lazily
+            const entry_type* _end_ptr = nullptr;
             bool _end_state;
             id_type _id;
             id_type _uid;
@@ -108,31 +204,140 @@ namespace lexertl
                 _multi_state_state;
             recursive_state<id_type, (flags & +feature_bit::recursive) != 0>
                 _recursive_state;
+            accel_tables<id_type, accel> _accel_tables;
+            profile_state<id_type, (flags & +feature_bit::profile) != 0>
+                _profile_state;
 
-            lookup_state(const internals& internals_, const bool bol_,
-                const id_type state_) :
-                _lookup(&internals_._lookup[state_][0]),
-                _dfa_alphabet(internals_._dfa_alphabet[state_]),
-                _dfa(&internals_._dfa[state_][0]),
+            // Start a DFA walk from where results_ left off
+            template<typename results>
+            lookup_state(const internals& internals_, const results& results_) :
+                _lookup(internals_.template lookup<entry_type>
+                    (results_.state)),
+                _dfa_alphabet(internals_.dfa_alphabet(results_.state)),
+                _dfa(internals_.template dfa<entry_type>(results_.state)),
                 _ptr(_dfa + _dfa_alphabet),
                 _end_state(*_ptr != 0),
-                _id(*(_ptr + *state_index::id)),
-                _uid(*(_ptr + *state_index::user_id)),
-                _bol_state(bol_),
-                _multi_state_state(state_),
-                _recursive_state(_ptr)
+                _id(widen<id_type>(*(_ptr + *state_index::id))),
+                _uid(widen<id_type>(*(_ptr + *state_index::user_id))),
+                _bol_state(results_.bol),
+                _multi_state_state(results_.state),
+                _recursive_state(_ptr),
+                _accel_tables(internals_, results_.state),
+                _profile_state(results_, results_.state)
+            {
+            }
+
+            // Offset of the row for state_ within _dfa
+            std::size_t row(const id_type state_, const std::false_type&) const
+            {
+                return state_ * _dfa_alphabet;
+            }
+
+            std::size_t row(const id_type state_, const std::true_type&) const
+            {
+                return state_;
+            }
+
+            std::size_t row(const id_type state_) const
+            {
+                return row(state_,
+                    std::integral_constant<bool, row_offsets>());
+            }
+
+            template<typename iter_type>
+            void accelerate(const id_type, iter_type&, const iter_type&,
+                const std::false_type&) const
             {
+                // Do nothing
+            }
+
+            // Skip a run of a self looping state in one go.
+            template<typename iter_type>
+            void accelerate(const id_type state_, iter_type& curr_,
+                const iter_type& eoi_, const std::true_type&) const
+            {
+                if (_accel_tables._bits[state_ / 8] & (1 << (state_ % 8)))
+                {
+                    const accel_state& accel_ = _accel_tables._rows
+                        [row_offsets ? state_ / _dfa_alphabet : state_];
+
+                    curr_ = accel_.find(curr_, eoi_);
+                }
             }
 
-            void reset_recursive(const std::false_type&) const
+            void visit(const id_type, const std::false_type&) const
             {
                 // Do nothing
             }
 
-            void reset_recursive(const std::true_type&)
+            // Count entering state_ (a row offset when row_offsets).
+            void visit(const id_type state_, const std::true_type&)
             {
-                _recursive_state._pop = (*_ptr & *state_bit::pop_dfa) != 0;
-                _recursive_state._push_dfa = *(_ptr + *state_index::push_dfa);
+                if (_profile_state._profile)
+                {
+                    _profile_state._profile->visit(_profile_state._dfa,
+                        row_offsets ? state_ / _dfa_alphabet : state_);
+                }
+            }
+
+            void examine(const std::false_type&) const
+            {
+                // Do nothing
+            }
+
+            void examine(const std::true_type&)
+            {
+                ++_profile_state._examined;
+            }
+
+            void profile_accept(const std::false_type&) const
+            {
+                // Do nothing
+            }
+
+            void profile_accept(const std::true_type&)
+            {
+                _profile_state._consumed = _profile_state._examined;
+            }
+
+            void profile_finish(const std::false_type&) const
+            {
+                // Do nothing
+            }
+
+            // Add the counts of this walk to the profile.
+            void profile_finish(const std::true_type&)
+            {
+                basic_profile<id_type>* profile_ = _profile_state._profile;
+
+                if (profile_)
+                {
+                    profile_->_examined += _profile_state._examined;
+
+                    if (_end_state)
+                    {
+                        profile_->_consumed += _profile_state._consumed;
+                        profile_->match(_id);
+                    }
+                    else if (flags & +feature_bit::advance)
+                    {
+                        ++profile_->_consumed;
+                    }
+                }
+            }
+
+            void reset_recursive(const entry_type* const,
+                const std::false_type&) const
+            {
+                // Do nothing
+            }
+
+            void reset_recursive(const entry_type* const ptr_,
+                const std::true_type&)
+            {
+                _recursive_state._pop = (*ptr_ & *state_bit::pop_dfa) != 0;
+                _recursive_state._push_dfa =
+                    widen<id_type>(*(ptr_ + *state_index::push_dfa));
             }
 
             void bol_start_state(const std::false_type&) const
@@ -148,7 +353,7 @@ namespace lexertl
 
                     if (state_)
                     {
-                        _ptr = &_dfa[state_ * _dfa_alphabet];
+                        _ptr = &_dfa[row(state_)];
                     }
                 }
             }
@@ -170,7 +375,9 @@ namespace lexertl
 
                 if (ret_)
                 {
-                    _ptr = &_dfa[_eol_state._EOL_state * _dfa_alphabet];
+                    _ptr = &_dfa[row(_eol_state._EOL_state)];
+                    visit(_eol_state._EOL_state, std::integral_constant<bool,
+                        (flags & +feature_bit::profile) != 0>());
                 }
 
                 return ret_;
@@ -185,7 +392,38 @@ namespace lexertl
 
                 if (state_ != 0)
                 {
-                    _ptr = &_dfa[state_ * _dfa_alphabet];
+                    _ptr = &_dfa[row(state_)];
+                }
+
+                return state_;
+            }
+
+            // One lookup per code point
+            template<typename char_type>
+            id_type next_char(const char_type prev_char_, const paged_type&)
+            {
+                const std::size_t char_ = static_cast<std::size_t>
+                    (static_cast<typename std::make_unsigned<char_type>::type>
+                    (prev_char_));
+                std::size_t idx_ = char_;
+
+                if (char_ >= paged_lookup::page)
+                {
+                    if (char_ > paged_lookup::max_char)
+                    {
+                        return 0;
+                    }
+
+                    idx_ = static_cast<std::size_t>(widen<id_type>
+                        (_lookup[paged_lookup::index + (char_ >> 8)])) *
+                        paged_lookup::page + (char_ & 0xff);
+                }
+
+                const id_type state_ = _ptr[_lookup[idx_]];
+
+                if (state_ != 0)
+                {
+                    _ptr = &_dfa[row(state_)];
                 }
 
                 return state_;
@@ -209,7 +447,7 @@ namespace lexertl
                         break;
                     }
 
-                    _ptr = &_dfa[state_ * _dfa_alphabet];
+                    _ptr = &_dfa[row(state_)];
                 }
 
                 return state_;
@@ -237,15 +475,17 @@ namespace lexertl
                 _eol_state._EOL_state = err_val_;
             }
 
-            void reset_start_state(const std::false_type&) const
+            void reset_start_state(const entry_type* const,
+                const std::false_type&) const
             {
                 // Do nothing
             }
 
-            void reset_start_state(const std::true_type&)
+            void reset_start_state(const entry_type* const ptr_,
+                const std::true_type&)
             {
                 _multi_state_state._start_state =
-                    *(_ptr + *state_index::next_dfa);
+                    *(ptr_ + *state_index::next_dfa);
             }
 
             void reset_end_bol(const std::false_type&) const
@@ -258,25 +498,70 @@ namespace lexertl
                 _bol_state._end_bol = _bol_state._bol;
             }
 
+            // Take the token details from the accepting row ptr_.
+            void accept(const entry_type* const ptr_)
+            {
+                _end_state = true;
+                _id = widen<id_type>(*(ptr_ + *state_index::id));
+                _uid = widen<id_type>(*(ptr_ + *state_index::user_id));
+                reset_recursive(ptr_, std::integral_constant<bool,
+                    (flags & +feature_bit::recursive) != 0>());
+                reset_start_state(ptr_, std::integral_constant<bool,
+                    (flags & +feature_bit::multi_state) != 0>());
+            }
+
             template<typename iter_type>
             void end_state(iter_type& end_token_, iter_type& curr_)
             {
                 if (*_ptr)
                 {
-                    _end_state = true;
                     reset_end_bol
                     (std::integral_constant<bool,
                         (flags & +feature_bit::bol) != 0>());
-                    _id = *(_ptr + *state_index::id);
-                    _uid = *(_ptr + *state_index::user_id);
-                    reset_recursive(std::integral_constant<bool,
-                        (flags & +feature_bit::recursive) != 0>());
-                    reset_start_state(std::integral_constant<bool,
-                        (flags & +feature_bit::multi_state) != 0>());
+                    accept(_ptr);
+                    profile_accept(std::integral_constant<bool,
+                        (flags & +feature_bit::profile) != 0>());
+                    end_token_ = curr_;
+                }
+            }
+
+            template<typename iter_type>
+            void end_state(iter_type& end_token_, iter_type& curr_,
+                const std::false_type&)
+            {
+                end_state(end_token_, curr_);
+            }
+
+            // Only remember the accepting row, see accept_end().
+            template<typename iter_type>
+            void end_state(iter_type& end_token_, iter_type& curr_,
+                const std::true_type&)
+            {
+                if (*_ptr)
+                {
+                    reset_end_bol
+                    (std::integral_constant<bool,
+                        (flags & +feature_bit::bol) != 0>());
+                    _end_ptr = _ptr;
+                    profile_accept(std::integral_constant<bool,
+                        (flags & +feature_bit::profile) != 0>());
                     end_token_ = curr_;
                 }
             }
 
+            void accept_end(const std::false_type&) const
+            {
+                // Do nothing
+            }
+
+            void accept_end(const std::true_type&)
+            {
+                if (_end_ptr)
+                {
+                    accept(_end_ptr);
+                }
+            }
+
             template<typename iter_type, typename char_type>
             void check_eol(iter_type&, iter_type&, const id_type,
                 const char_type, const std::false_type&) const
@@ -295,7 +580,10 @@ namespace lexertl
 
                     if (_eol_state._EOL_state)
                     {
-                        _ptr = &_dfa[_eol_state._EOL_state * _dfa_alphabet];
+                        _ptr = &_dfa[row(_eol_state._EOL_state)];
+                        visit(_eol_state._EOL_state,
+                            std::integral_constant<bool,
+                            (flags & +feature_bit::profile) != 0>());
                         end_state(end_token_, curr_);
                     }
                 }
@@ -361,28 +649,119 @@ namespace lexertl
             {
                 end_bol_ = _bol_state._end_bol;
             }
-        };
 
-        template<typename results>
-        void inc_end(results&, const std::false_type&)
-        {
-            // Do nothing
-        }
+            // Consume the character at curr_. Returns false if there is no
+            // transition for it. When lazy, accepting rows are decoded by
+            // finish() rather than here.
+            template<typename iter_type, typename compressed,
+                typename lazy = std::false_type>
+            bool step(iter_type& curr_, iter_type& end_token_,
+                const iter_type& eoi_, const compressed& compressed_,
+                const lazy& lazy_ = lazy())
+            {
+                if (!is_eol(*curr_, std::integral_constant<bool,
+                    (flags & +feature_bit::eol) != 0>()))
+                {
+                    const auto prev_char_ = *curr_;
+                    const id_type state_ = next_char(prev_char_, compressed_);
 
-        template<typename results>
-        void inc_end(results& results_, const std::true_type&)
-        {
-            ++results_.second;
-        }
+                    examine(std::integral_constant<bool,
+                        (flags & +feature_bit::profile) != 0>());
+
+                    bol(prev_char_, std::integral_constant<bool,
+                        (flags & +feature_bit::bol) != 0>());
+
+                    if (state_ == 0)
+                    {
+                        is_eol(static_cast<id_type>(~0),
+                            std::integral_constant<bool,
+                            (flags & +feature_bit::eol) != 0>());
+                        return false;
+                    }
+
+                    visit(state_, std::integral_constant<bool,
+                        (flags & +feature_bit::profile) != 0>());
+                    ++curr_;
+                    accelerate(state_, curr_, eoi_,
+                        std::integral_constant<bool, accel>());
+                }
+
+                end_state(end_token_, curr_, lazy_);
+                return true;
+            }
 
-        template<typename sm_type, std::size_t flags, typename results,
-            bool compressed, bool recursive>
+            // Store the longest match in results_, unless it is to be
+            // skipped or was an end of input rule.
+            template<typename results, typename iter_type, typename recursive,
+                typename lazy = std::false_type>
+            token_end finish(results& results_, iter_type& end_token_,
+                iter_type& curr_, const id_type skip_, const id_type eoi_,
+                const recursive& recursive_, const lazy& lazy_ = lazy())
+            {
+                accept_end(lazy_);
+                check_eol(end_token_, curr_, results::npos(), results_.eoi,
+                    std::integral_constant<bool,
+                    (flags & +feature_bit::eol) != 0>());
+                profile_finish(std::integral_constant<bool,
+                    (flags & +feature_bit::profile) != 0>());
+
+                if (_end_state)
+                {
+                    // Return longest match
+                    pop(results_, recursive_);
+
+                    start_state(results_.state,
+                        std::integral_constant<bool,
+                        (flags & +feature_bit::multi_state) != 0>());
+                    bol(results_.bol, std::integral_constant<bool,
+                        (flags & +feature_bit::bol) != 0>());
+                    results_.second = end_token_;
+
+                    if (_id == skip_) return token_end::skip;
+
+                    if (is_id_eoi(eoi_, results_, recursive_))
+                    {
+                        curr_ = end_token_;
+                        return token_end::again;
+                    }
+                }
+                else
+                {
+                    results_.second = end_token_;
+                    results_.bol = *results_.second == '\n';
+                    results_.first = results_.second;
+                    // No match causes char to be skipped
+                    inc_end(results_,
+                        std::integral_constant<bool,
+                        (flags & +feature_bit::advance) != 0>());
+                    _id = results::npos();
+                    _uid = results::npos();
+                }
+
+                results_.id = _id;
+                results_.user_id = _uid;
+                return token_end::done;
+            }
+        };
+
+        template<typename entry_type, bool row_offsets, typename sm_type,
+            std::size_t flags, typename results, typename compressed,
+            bool recursive>
             void next(const sm_type& sm_, results& results_,
-                const std::integral_constant<bool, compressed>& compressed_,
+                const compressed& compressed_,
                 const std::integral_constant<bool, recursive>& recursive_,
                 const std::forward_iterator_tag&)
         {
             using id_type = typename sm_type::id_type;
+            // Only byte input addressed by pointers can be scanned ahead,
+            // and bol/eol and profiling need to see every character.
+            using accel = std::integral_constant<bool,
+                std::is_same<typename sm_type::internals,
+                    basic_flat_internals<id_type>>::value &&
+                !sm_type::traits::compressed && !compressed::value &&
+                std::is_pointer<typename results::iter_type>::value &&
+                (flags & (+feature_bit::bol | +feature_bit::eol |
+                +feature_bit::profile)) == 0>;
             const auto& internals_ = sm_.data();
             auto end_token_ = results_.second;
         skip:
@@ -399,76 +778,279 @@ namespace lexertl
             }
 
             lookup_state<typename sm_type::internals, id_type,
-                typename results::index_type, flags> lu_state_
-                (internals_, results_.bol, results_.state);
+                typename results::index_type, flags, entry_type, row_offsets,
+                accel::value> lu_state_(internals_, results_);
             lu_state_.bol_start_state
             (std::integral_constant<bool, (flags & +feature_bit::bol) != 0>());
 
-            while (curr_ != results_.eoi)
+            while (curr_ != results_.eoi &&
+                lu_state_.step(curr_, end_token_, results_.eoi, compressed_))
             {
-                if (!lu_state_.is_eol(*curr_, std::integral_constant<bool,
-                    (flags & +feature_bit::eol) != 0>()))
-                {
-                    const auto prev_char_ = *curr_;
-                    const id_type state_ = lu_state_.next_char(prev_char_,
-                        compressed_);
+            }
 
-                    lu_state_.bol(prev_char_, std::integral_constant<bool,
-                        (flags & +feature_bit::bol) != 0>());
+            switch (lu_state_.finish(results_, end_token_, curr_, sm_.skip(),
+                internals_._eoi, recursive_))
+            {
+            case token_end::skip:
+                goto skip;
+            case token_end::again:
+                goto again;
+            default:
+                break;
+            }
+        }
 
-                    if (state_ == 0)
-                    {
-                        lu_state_.is_eol(results::npos(),
-                            std::integral_constant<bool,
-                            (flags & +feature_bit::eol) != 0>());
-                        break;
-                    }
+        // As above, for input addressed by pointers. The walk runs on
+        // local copies of the position, end of token and end of input,
+        // and the accepting row is decoded once per token rather than on
+        // every accepting character.
+        template<typename entry_type, bool row_offsets, typename sm_type,
+            std::size_t flags, typename results, typename compressed,
+            bool recursive>
+            void next(const sm_type& sm_, results& results_,
+                const compressed& compressed_,
+                const std::integral_constant<bool, recursive>& recursive_,
+                const contiguous_iterator_tag&)
+        {
+            using id_type = typename sm_type::id_type;
+            using iter_type = typename results::iter_type;
+            using accel = std::integral_constant<bool,
+                std::is_same<typename sm_type::internals,
+                    basic_flat_internals<id_type>>::value &&
+                !sm_type::traits::compressed && !compressed::value &&
+                (flags & (+feature_bit::bol | +feature_bit::eol |
+                +feature_bit::profile)) == 0>;
+            const auto& internals_ = sm_.data();
+            const iter_type eoi_ = results_.eoi;
+            iter_type end_token_ = results_.second;
+            iter_type curr_ = end_token_;
 
-                    ++curr_;
-                }
+        skip:
+            curr_ = results_.second;
+            results_.first = curr_;
 
-                lu_state_.end_state(end_token_, curr_);
+        again:
+            if (curr_ == eoi_)
+            {
+                results_.id = internals_._eoi;
+                results_.user_id = results::npos();
+                return;
             }
 
-            lu_state_.check_eol(end_token_, curr_,
-                results::npos(), results_.eoi, std::integral_constant<bool,
-                (flags & +feature_bit::eol) != 0>());
+            lookup_state<typename sm_type::internals, id_type,
+                typename results::index_type, flags, entry_type, row_offsets,
+                accel::value> lu_state_(internals_, results_);
+            lu_state_.bol_start_state
+            (std::integral_constant<bool, (flags & +feature_bit::bol) != 0>());
 
-            if (lu_state_._end_state)
+            while (curr_ != eoi_ && lu_state_.step(curr_, end_token_, eoi_,
+                compressed_, std::true_type()))
             {
-                // Return longest match
-                lu_state_.pop(results_, recursive_);
+            }
 
-                lu_state_.start_state(results_.state,
-                    std::integral_constant<bool,
-                    (flags & +feature_bit::multi_state) != 0>());
-                lu_state_.bol(results_.bol, std::integral_constant<bool,
+            switch (lu_state_.finish(results_, end_token_, curr_, sm_.skip(),
+                internals_._eoi, recursive_, std::true_type()))
+            {
+            case token_end::skip:
+                goto skip;
+            case token_end::again:
+                goto again;
+            default:
+                break;
+            }
+        }
+
+        // As above, but for n independent inputs at once. Every stream
+        // advances by one character per pass over the streams, so that the
+        // table loads of the different streams overlap instead of each
+        // waiting for the previous one.
+        template<typename entry_type, bool row_offsets, typename sm_type,
+            std::size_t flags, typename results, std::size_t n,
+            typename compressed, bool recursive>
+            void next(const sm_type& sm_, std::array<results, n>& results_,
+                const compressed& compressed_,
+                const std::integral_constant<bool, recursive>& recursive_,
+                const std::forward_iterator_tag&)
+        {
+            using id_type = typename sm_type::id_type;
+            using iter_type = typename results::iter_type;
+            using accel = std::integral_constant<bool,
+                std::is_same<typename sm_type::internals,
+                    basic_flat_internals<id_type>>::value &&
+                !sm_type::traits::compressed && !compressed::value &&
+                std::is_pointer<iter_type>::value &&
+                (flags & (+feature_bit::bol | +feature_bit::eol |
+                +feature_bit::profile)) == 0>;
+            using lu_state = lookup_state<typename sm_type::internals, id_type,
+                typename results::index_type, flags, entry_type, row_offsets,
+                accel::value>;
+            static_assert(std::is_trivially_destructible<lu_state>::value,
+                "lookup_state must be trivially destructible");
+            const auto& internals_ = sm_.data();
+            // Each walk is only constructed once its token starts, as the
+            // constructor counts the start in any profile.
+            std::array<typename std::aligned_storage<sizeof(lu_state),
+                alignof(lu_state)>::type, n> storage_;
+            auto state_ = [&](const std::size_t idx_) -> lu_state&
+            {
+                return *reinterpret_cast<lu_state*>(&storage_[idx_]);
+            };
+            std::array<iter_type, n> curr_;
+            std::array<iter_type, n> end_token_;
+            std::array<bool, n> active_;
+            std::size_t count_ = 0;
+            // Start (or restart) the token of stream idx_, returning false
+            // if the stream is at the end of its input.
+            auto begin_ = [&](const std::size_t idx_, const bool skip_)
+            {
+                auto& res_ = results_[idx_];
+
+                if (skip_)
+                {
+                    curr_[idx_] = res_.second;
+                    res_.first = curr_[idx_];
+                }
+
+                if (curr_[idx_] == res_.eoi)
+                {
+                    res_.id = internals_._eoi;
+                    res_.user_id = results::npos();
+                    return false;
+                }
+
+                new (&storage_[idx_]) lu_state(internals_, res_);
+                state_(idx_).bol_start_state(std::integral_constant<bool,
                     (flags & +feature_bit::bol) != 0>());
-                results_.second = end_token_;
+                return true;
+            };
 
-                if (lu_state_._id == sm_.skip()) goto skip;
+            for (std::size_t idx_ = 0; idx_ < n; ++idx_)
+            {
+                end_token_[idx_] = results_[idx_].second;
+                active_[idx_] = begin_(idx_, true);
+                count_ += active_[idx_];
+            }
 
-                if (lu_state_.is_id_eoi(internals_._eoi, results_, recursive_))
+            while (count_)
+            {
+                for (std::size_t idx_ = 0; idx_ < n; ++idx_)
                 {
-                    curr_ = end_token_;
-                    goto again;
+                    if (!active_[idx_] || (curr_[idx_] != results_[idx_].eoi &&
+                        state_(idx_).step(curr_[idx_], end_token_[idx_],
+                            results_[idx_].eoi, compressed_)))
+                    {
+                        continue;
+                    }
+
+                    switch (state_(idx_).finish(results_[idx_],
+                        end_token_[idx_], curr_[idx_], sm_.skip(),
+                        internals_._eoi, recursive_))
+                    {
+                    case token_end::skip:
+                        active_[idx_] = begin_(idx_, true);
+                        break;
+                    case token_end::again:
+                        active_[idx_] = begin_(idx_, false);
+                        break;
+                    default:
+                        active_[idx_] = false;
+                        break;
+                    }
+
+                    count_ -= !active_[idx_];
                 }
             }
+        }
+
+        template<typename entry_type, bool row_offsets, typename sm_type,
+            std::size_t flags, typename internals, typename results,
+            typename recursive, typename category>
+        void next_paged(const sm_type& sm_, const internals&,
+            results& results_, const std::false_type& compressed_,
+            const recursive& recursive_, const category& category_)
+        {
+            next<entry_type, row_offsets, sm_type, flags>(sm_, results_,
+                compressed_, recursive_, category_);
+        }
+
+        // Wide characters are classified a code point at a time if the
+        // machine has paged lookup tables.
+        template<typename entry_type, bool row_offsets, typename sm_type,
+            std::size_t flags, typename internals, typename results,
+            typename recursive, typename category>
+        void next_paged(const sm_type& sm_, const internals& internals_,
+            results& results_, const std::true_type& compressed_,
+            const recursive& recursive_, const category& category_)
+        {
+            if (internals_.paged())
+                next<entry_type, row_offsets, sm_type, flags>(sm_, results_,
+                    paged_type(), recursive_, category_);
+            else
+                next<entry_type, row_offsets, sm_type, flags>(sm_, results_,
+                    compressed_, recursive_, category_);
+        }
+
+        template<typename sm_type, std::size_t flags, typename id_type,
+            typename results, typename compressed, typename recursive,
+            typename category>
+        void next(const sm_type& sm_,
+            const basic_internals<id_type>& internals_,
+            results& results_, const compressed& compressed_,
+            const recursive& recursive_, const category& category_)
+        {
+            next_paged<id_type, false, sm_type, flags>(sm_, internals_,
+                results_, compressed_, recursive_, category_);
+        }
+
+        template<typename entry_type, typename sm_type, std::size_t flags,
+            typename id_type, typename results, typename compressed,
+            typename recursive, typename category>
+        void next_flat(const sm_type& sm_,
+            const basic_flat_internals<id_type>& internals_,
+            results& results_, const compressed& compressed_,
+            const recursive& recursive_, const category& category_)
+        {
+            if (internals_._row_offsets)
+                next_paged<entry_type, true, sm_type, flags>(sm_, internals_,
+                    results_, compressed_, recursive_, category_);
             else
+                next_paged<entry_type, false, sm_type, flags>(sm_,
+                    internals_, results_, compressed_, recursive_, category_);
+        }
+
+        // Select the kernel for the table width and row layout of the
+        // machine.
+        template<typename sm_type, std::size_t flags, typename id_type,
+            typename results, typename compressed, typename recursive,
+            typename category>
+        void next(const sm_type& sm_,
+            const basic_flat_internals<id_type>& internals_,
+            results& results_, const compressed& compressed_,
+            const recursive& recursive_, const category& category_)
+        {
+            switch (internals_._entry_size)
             {
-                results_.second = end_token_;
-                results_.bol = *results_.second == '\n';
-                results_.first = results_.second;
-                // No match causes char to be skipped
-                inc_end(results_,
-                    std::integral_constant<bool,
-                    (flags & +feature_bit::advance) != 0>());
-                lu_state_._id = results::npos();
-                lu_state_._uid = results::npos();
+            case 1:
+                next_flat<flat_entry<uint8_t, id_type>, sm_type, flags>
+                    (sm_, internals_, results_, compressed_, recursive_,
+                    category_);
+                break;
+            case 2:
+                next_flat<flat_entry<uint16_t, id_type>, sm_type, flags>
+                    (sm_, internals_, results_, compressed_, recursive_,
+                    category_);
+                break;
+            case 4:
+                next_flat<flat_entry<uint32_t, id_type>, sm_type, flags>
+                    (sm_, internals_, results_, compressed_, recursive_,
+                    category_);
+                break;
+            default:
+                next_flat<id_type, sm_type, flags>
+                    (sm_, internals_, results_, compressed_, recursive_,
+                    category_);
+                break;
             }
-
-            results_.id = lu_state_._id;
-            results_.user_id = lu_state_._uid;
         }
     }
 
@@ -477,13 +1059,13 @@ namespace lexertl
         typename sm_type::id_type, flags>& results_)
     {
         using value_type = typename std::iterator_traits<iter_type>::value_type;
-        using cat = typename std::iterator_traits<iter_type>::iterator_category;
+        using cat = detail::iterator_tag<iter_type>;
 
         // If this asserts, you have either not defined all the correct
         // flags, or you should be using recursive_match_results instead
         // of match_results.
         assert((sm_.data()._features & flags) == sm_.data()._features);
-        detail::next<sm_type, flags>(sm_, results_,
+        detail::next<sm_type, flags>(sm_, sm_.data(), results_,
             std::integral_constant<bool, (sizeof(value_type) > 1)>(),
             std::false_type(), cat());
     }
@@ -493,11 +1075,43 @@ namespace lexertl
         typename sm_type::id_type, flags>& results_)
     {
         using value_type = typename std::iterator_traits<iter_type>::value_type;
-        using cat = typename std::iterator_traits<iter_type>::iterator_category;
+        using cat = detail::iterator_tag<iter_type>;
 
         // If this asserts, you have not defined all the correct flags
         assert((sm_.data()._features & flags) == sm_.data()._features);
-        detail::next<sm_type, flags | +feature_bit::recursive>(sm_, results_,
+        detail::next<sm_type, flags | +feature_bit::recursive>(sm_,
+            sm_.data(), results_,
+            std::integral_constant<bool, (sizeof(value_type) > 1)>(),
+            std::true_type(), cat());
+    }
+
+    // Finds the next token of each of n independent inputs, interleaving
+    // the DFA walks. Equivalent to calling lookup() on each in turn.
+    template<typename iter_type, typename sm_type, std::size_t flags,
+        std::size_t n>
+    void lookup(const sm_type& sm_, std::array<match_results<iter_type,
+        typename sm_type::id_type, flags>, n>& results_)
+    {
+        using value_type = typename std::iterator_traits<iter_type>::value_type;
+        using cat = typename std::iterator_traits<iter_type>::iterator_category;
+
+        assert((sm_.data()._features & flags) == sm_.data()._features);
+        detail::next<sm_type, flags>(sm_, sm_.data(), results_,
+            std::integral_constant<bool, (sizeof(value_type) > 1)>(),
+            std::false_type(), cat());
+    }
+
+    template<typename iter_type, typename sm_type, std::size_t flags,
+        std::size_t n>
+    void lookup(const sm_type& sm_, std::array<recursive_match_results
+        <iter_type, typename sm_type::id_type, flags>, n>& results_)
+    {
+        using value_type = typename std::iterator_traits<iter_type>::value_type;
+        using cat = typename std::iterator_traits<iter_type>::iterator_category;
+
+        assert((sm_.data()._features & flags) == sm_.data()._features);
+        detail::next<sm_type, flags | +feature_bit::recursive>(sm_,
+            sm_.data(), results_,
             std::integral_constant<bool, (sizeof(value_type) > 1)>(),
             std::true_type(), cat());
     }
@@ -9,6 +9,7 @@
 #include "char_traits.hpp"
 #include "enum_operator.hpp"
 #include "enums.hpp"
+#include "profile.hpp"
 
 #include <cstdint>
 #include <iterator>
@@ -22,7 +23,8 @@ namespace lexertl
         std::size_t flags = +feature_bit::bol | +feature_bit::eol |
         +feature_bit::skip | +feature_bit::again | +feature_bit::multi_state |
         +feature_bit::advance>
-    struct match_results
+    struct match_results : detail::match_profile<id_t,
+        (flags & +feature_bit::profile) != 0>
     {
         using id_type = id_t;
         using iter_type = iter;
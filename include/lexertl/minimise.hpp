@@ -0,0 +1,280 @@
+// minimise.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_MINIMISE_HPP
+#define LEXERTL_MINIMISE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace lexertl
+{
+    namespace detail
+    {
+        // Hopcroft's partition refinement, as used by the minimise()
+        // members of the state machines. States are numbered from 0 and
+        // start off in the blocks given to the constructor (states that
+        // differ other than by their transitions must start in different
+        // blocks). Every transition that does not go to the implicit dead
+        // state is then added with add(), after which refine() splits the
+        // blocks until the states in each block are equivalent.
+        // index_type must be able to hold every state and symbol number.
+        template<typename index_type>
+        class basic_partition_refiner
+        {
+        public:
+            using index_vector = std::vector<index_type>;
+
+            explicit basic_partition_refiner(const index_vector& blocks_) :
+                _block(blocks_),
+                _rev_start(blocks_.size() + 1, 0)
+            {
+            }
+
+            void add(const index_type symbol_, const index_type source_,
+                const index_type target_)
+            {
+                _edges.emplace_back(target_, std::make_pair(symbol_, source_));
+            }
+
+            // Returns the block of each state, with blocks numbered in
+            // order of their first state.
+            index_vector refine()
+            {
+                const std::size_t size_ = _block.size();
+                std::vector<index_type> worklist_;
+                std::vector<std::pair<index_type, index_type>> splitter_;
+                index_vector ret_(size_);
+                index_vector number_;
+
+                build_reverse();
+                build_blocks();
+
+                for (index_type block_ = 0; block_ < _first.size(); ++block_)
+                {
+                    worklist_.push_back(block_);
+                    _in_worklist[block_] = true;
+                }
+
+                while (!worklist_.empty())
+                {
+                    const index_type block_ = worklist_.back();
+
+                    worklist_.pop_back();
+                    _in_worklist[block_] = false;
+                    splitter_.clear();
+
+                    // Everything that moves into the splitter, gathered
+                    // before any block (including this one) is split.
+                    for (std::size_t i_ = _first[block_], end_ = _end[block_];
+                        i_ < end_; ++i_)
+                    {
+                        const index_type state_ = _elems[i_];
+
+                        splitter_.insert(splitter_.end(),
+                            _rev.cbegin() + _rev_start[state_],
+                            _rev.cbegin() + _rev_start[state_ + 1]);
+                    }
+
+                    std::sort(splitter_.begin(), splitter_.end());
+
+                    for (auto iter_ = splitter_.cbegin(),
+                        end_ = splitter_.cend(); iter_ != end_;)
+                    {
+                        const index_type symbol_ = iter_->first;
+
+                        for (; iter_ != end_ && iter_->first == symbol_;
+                            ++iter_)
+                        {
+                            mark(iter_->second);
+                        }
+
+                        split(worklist_);
+                    }
+                }
+
+                number_.resize(_first.size(), static_cast<index_type>(~0));
+
+                for (std::size_t state_ = 0, next_ = 0; state_ < size_;
+                    ++state_)
+                {
+                    index_type& number_ref_ = number_[_block[state_]];
+
+                    if (number_ref_ == static_cast<index_type>(~0))
+                    {
+                        number_ref_ = static_cast<index_type>(next_++);
+                    }
+
+                    ret_[state_] = number_ref_;
+                }
+
+                return ret_;
+            }
+
+        private:
+            // Current block of each state
+            index_vector _block;
+            // (target, (symbol, source)) until build_reverse() is called
+            std::vector<std::pair<index_type, std::pair<index_type,
+                index_type>>> _edges;
+            // (symbol, source) of every transition into each state
+            std::vector<std::size_t> _rev_start;
+            std::vector<std::pair<index_type, index_type>> _rev;
+            // The states of each block are _elems[_first, _end), with the
+            // states marked by the current splitter in [_first, _mid).
+            index_vector _elems;
+            index_vector _loc;
+            index_vector _first;
+            index_vector _mid;
+            index_vector _end;
+            std::vector<bool> _in_worklist;
+            index_vector _touched;
+
+            void build_reverse()
+            {
+                const std::size_t size_ = _block.size();
+
+                for (const auto& edge_ : _edges)
+                {
+                    ++_rev_start[edge_.first + 1];
+                }
+
+                for (std::size_t i_ = 0; i_ < size_; ++i_)
+                {
+                    _rev_start[i_ + 1] += _rev_start[i_];
+                }
+
+                std::vector<std::size_t> pos_(_rev_start.cbegin(),
+                    _rev_start.cend() - 1);
+
+                _rev.resize(_edges.size());
+
+                for (const auto& edge_ : _edges)
+                {
+                    _rev[pos_[edge_.first]++] = edge_.second;
+                }
+
+                _edges.clear();
+                _edges.shrink_to_fit();
+            }
+
+            void build_blocks()
+            {
+                const std::size_t size_ = _block.size();
+                std::size_t blocks_ = 0;
+
+                for (const index_type block_ : _block)
+                {
+                    blocks_ = std::max(blocks_,
+                        static_cast<std::size_t>(block_) + 1);
+                }
+
+                _first.assign(blocks_, 0);
+                _end.assign(blocks_, 0);
+                _in_worklist.assign(blocks_, false);
+                _elems.resize(size_);
+                _loc.resize(size_);
+
+                for (const index_type block_ : _block)
+                {
+                    ++_end[block_];
+                }
+
+                for (std::size_t b_ = 0, first_ = 0; b_ < blocks_; ++b_)
+                {
+                    _first[b_] = static_cast<index_type>(first_);
+                    first_ += _end[b_];
+                    _end[b_] = _first[b_];
+                }
+
+                for (std::size_t state_ = 0; state_ < size_; ++state_)
+                {
+                    index_type& end_ = _end[_block[state_]];
+
+                    _elems[end_] = static_cast<index_type>(state_);
+                    _loc[state_] = end_++;
+                }
+
+                _mid = _first;
+            }
+
+            void mark(const index_type state_)
+            {
+                const index_type block_ = _block[state_];
+                const index_type loc_ = _loc[state_];
+                const index_type mid_ = _mid[block_];
+
+                if (loc_ < mid_)
+                {
+                    // Already marked
+                    return;
+                }
+
+                if (mid_ == _first[block_])
+                {
+                    _touched.push_back(block_);
+                }
+
+                _elems[loc_] = _elems[mid_];
+                _loc[_elems[loc_]] = loc_;
+                _elems[mid_] = state_;
+                _loc[state_] = mid_;
+                ++_mid[block_];
+            }
+
+            void split(std::vector<index_type>& worklist_)
+            {
+                for (const index_type block_ : _touched)
+                {
+                    const index_type mid_ = _mid[block_];
+
+                    if (mid_ == _end[block_])
+                    {
+                        // Every state was marked
+                        _mid[block_] = _first[block_];
+                        continue;
+                    }
+
+                    // The marked states become the new block
+                    const auto new_ = static_cast<index_type>(_first.size());
+
+                    _first.push_back(_first[block_]);
+                    _mid.push_back(_first[block_]);
+                    _end.push_back(mid_);
+                    _first[block_] = mid_;
+
+                    for (index_type i_ = _first[new_]; i_ < mid_; ++i_)
+                    {
+                        _block[_elems[i_]] = new_;
+                    }
+
+                    if (_in_worklist[block_])
+                    {
+                        _in_worklist.push_back(true);
+                        worklist_.push_back(new_);
+                    }
+                    else if (_end[new_] - _first[new_] <
+                        _end[block_] - _first[block_])
+                    {
+                        _in_worklist.push_back(true);
+                        worklist_.push_back(new_);
+                    }
+                    else
+                    {
+                        _in_worklist.push_back(false);
+                        _in_worklist[block_] = true;
+                        worklist_.push_back(block_);
+                    }
+                }
+
+                _touched.clear();
+            }
+        };
+    }
+}
+
+#endif
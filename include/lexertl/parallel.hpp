@@ -0,0 +1,237 @@
+// parallel.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_PARALLEL_HPP
+#define LEXERTL_PARALLEL_HPP
+
+#include "batch.hpp"
+#include "lookup.hpp"
+#include "match_results.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace lexertl
+{
+    namespace detail
+    {
+        template<typename id_type>
+        struct spec_token
+        {
+            // Where lookup() was called from and with which state
+            std::size_t begin = 0;
+            id_type state = 0;
+            bool bol = true;
+            // The token it found
+            id_type id = 0;
+            id_type user_id = 0;
+            std::size_t start = 0;
+            std::size_t length = 0;
+        };
+
+        // The tokens found by lexing one chunk of the input from a guessed
+        // start state.
+        template<typename id_type>
+        struct spec_chunk
+        {
+            std::vector<spec_token<id_type>> _tokens;
+            // Where (and with which state) the next lookup() would have
+            // started, or _eoi if the input ran out.
+            std::size_t _end = 0;
+            id_type _state = 0;
+            bool _bol = true;
+            bool _eoi = false;
+        };
+
+        // Lex every token starting in [begin_, end_), guessing that
+        // begin_ is a token boundary in the initial lexer state.
+        template<typename sm_type, typename iter_type, std::size_t flags>
+        spec_chunk<typename sm_type::id_type> lex_chunk(const sm_type& sm_,
+            const iter_type first_, const iter_type last_,
+            const std::size_t begin_, const std::size_t end_)
+        {
+            using id_type = typename sm_type::id_type;
+            spec_chunk<id_type> chunk_;
+            match_results<iter_type, id_type, flags> results_(first_ + begin_,
+                last_, begin_ == 0 || first_[begin_ - 1] == '\n');
+
+            for (;;)
+            {
+                const std::size_t pos_ =
+                    static_cast<std::size_t>(results_.second - first_);
+                spec_token<id_type> token_;
+
+                if (pos_ >= end_)
+                {
+                    chunk_._end = pos_;
+                    chunk_._state = results_.state;
+                    chunk_._bol = results_.bol;
+                    break;
+                }
+
+                token_.begin = pos_;
+                token_.state = results_.state;
+                token_.bol = results_.bol;
+                lookup(sm_, results_);
+
+                if (results_.id == sm_.eoi() && results_.first == last_)
+                {
+                    chunk_._eoi = true;
+                    break;
+                }
+
+                token_.id = results_.id;
+                token_.user_id = results_.user_id;
+                token_.start =
+                    static_cast<std::size_t>(results_.first - first_);
+                token_.length =
+                    static_cast<std::size_t>(results_.second - results_.first);
+                chunk_._tokens.push_back(token_);
+            }
+
+            return chunk_;
+        }
+
+        template<typename buffer, typename id_type>
+        void push_token(buffer& buffer_, const id_type id_,
+            const id_type user_id_, const std::size_t start_,
+            const std::size_t length_)
+        {
+            buffer_.id.push_back(id_);
+            buffer_.user_id.push_back(user_id_);
+            buffer_.start.push_back(start_);
+            buffer_.length.push_back(length_);
+        }
+    }
+
+    // Tokenises [first_, last_) using threads_ threads and stores every
+    // token in buffer_ (whose columns are resized to fit), giving exactly
+    // the tokens that tokenise_batch() would.
+    //
+    // The input is split into one chunk per thread. Every chunk but the
+    // first is lexed by a worker from its start, guessing that it begins a
+    // token in the initial lexer state, while the calling thread lexes the
+    // first chunk. The chunks are then stitched together in order: the true
+    // token stream is lexed sequentially from the end of the previous
+    // chunk until it reaches a point where the guessed stream called
+    // lookup() from the same position, lexer state and bol flag, after
+    // which the two streams are identical and the rest of the guessed
+    // tokens are used as is.
+    //
+    // recursive_match_results are not supported, as the stack cannot be
+    // guessed.
+    template<typename sm_type, typename iter_type, std::size_t flags>
+    void tokenise_parallel(const sm_type& sm_, const iter_type first_,
+        const iter_type last_, basic_token_buffer<iter_type,
+        typename sm_type::id_type, flags>& buffer_,
+        std::size_t threads_ = std::thread::hardware_concurrency())
+    {
+        static_assert(std::is_base_of<std::random_access_iterator_tag,
+            typename std::iterator_traits<iter_type>::iterator_category>::
+            value, "tokenise_parallel() needs random access iterators");
+
+        using id_type = typename sm_type::id_type;
+        using chunk = detail::spec_chunk<id_type>;
+        const std::size_t size_ = static_cast<std::size_t>(last_ - first_);
+        std::vector<std::size_t> bounds_;
+        std::vector<std::future<chunk>> futures_;
+        match_results<iter_type, id_type, flags> results_(first_, last_);
+
+        if (threads_ == 0)
+            threads_ = 1;
+
+        for (std::size_t i_ = 0; i_ <= threads_; ++i_)
+        {
+            bounds_.push_back(size_ / threads_ * i_ +
+                (i_ == threads_ ? size_ % threads_ : 0));
+        }
+
+        for (std::size_t i_ = 1; i_ < threads_; ++i_)
+        {
+            futures_.push_back(std::async(std::launch::async,
+                detail::lex_chunk<sm_type, iter_type, flags>, std::cref(sm_),
+                first_, last_, bounds_[i_], bounds_[i_ + 1]));
+        }
+
+        buffer_.clear();
+        buffer_.id.clear();
+        buffer_.user_id.clear();
+        buffer_.start.clear();
+        buffer_.length.clear();
+
+        for (std::size_t i_ = 0; i_ < threads_; ++i_)
+        {
+            // The first chunk starts in a known state so is never guessed
+            const chunk chunk_ = i_ == 0 ? chunk() : futures_[i_ - 1].get();
+            auto iter_ = chunk_._tokens.cbegin();
+            const auto end_ = chunk_._tokens.cend();
+
+            for (;;)
+            {
+                const std::size_t pos_ =
+                    static_cast<std::size_t>(results_.second - first_);
+
+                if (pos_ >= bounds_[i_ + 1])
+                    break;
+
+                while (iter_ != end_ && iter_->begin < pos_)
+                {
+                    ++iter_;
+                }
+
+                if (iter_ != end_ && iter_->begin == pos_ &&
+                    iter_->state == results_.state &&
+                    iter_->bol == results_.bol)
+                {
+                    // Converged with the guessed stream
+                    for (; iter_ != end_; ++iter_)
+                    {
+                        detail::push_token(buffer_, iter_->id,
+                            iter_->user_id, iter_->start, iter_->length);
+                    }
+
+                    if (chunk_._eoi)
+                    {
+                        results_.second = last_;
+                        break;
+                    }
+
+                    results_.second = first_ + chunk_._end;
+                    results_.state = chunk_._state;
+                    results_.bol = chunk_._bol;
+                    break;
+                }
+
+                lookup(sm_, results_);
+
+                if (results_.id == sm_.eoi() && results_.first == last_)
+                    break;
+
+                detail::push_token(buffer_, results_.id, results_.user_id,
+                    static_cast<std::size_t>(results_.first - first_),
+                    static_cast<std::size_t>(results_.second -
+                        results_.first));
+            }
+
+            if (results_.second == last_)
+            {
+                // Wait for any remaining workers before returning
+                for (; i_ < futures_.size(); ++i_)
+                {
+                    futures_[i_].wait();
+                }
+            }
+        }
+
+        buffer_.size = buffer_.id.size();
+    }
+}
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef LEXERTL_PARSER_HPP
 #define LEXERTL_PARSER_HPP
 
+#include "../arena.hpp"
 #include "../enums.hpp"
 #include "../observer_ptr.hpp"
 #include "../runtime_error.hpp"
@@ -19,12 +20,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <locale>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <stack>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace lexertl
@@ -103,25 +106,26 @@ namespace lexertl
                 observer_ptr<node> root_ = nullptr;
                 observer_ptr<token> lhs_token_ = nullptr;
                 // There cannot be less than 2 tokens
-                auto rhs_token_ = std::make_unique<token>(*iter_++);
+                observer_ptr<token> rhs_token_ =
+                    _token_arena.create<token>(*iter_++);
                 char action_ = 0;
 
-                _token_stack.push(std::move(rhs_token_));
-                rhs_token_ = std::make_unique<token>(*iter_);
+                _token_stack.push(rhs_token_);
+                rhs_token_ = _token_arena.create<token>(*iter_);
 
                 if (iter_ + 1 != end_) ++iter_;
 
                 do
                 {
-                    lhs_token_ = _token_stack.top().get();
+                    lhs_token_ = _token_stack.top();
                     action_ = lhs_token_->precedence(rhs_token_->_type);
 
                     switch (action_)
                     {
                     case '<':
                     case '=':
-                        _token_stack.push(std::move(rhs_token_));
-                        rhs_token_ = std::make_unique<token>(*iter_);
+                        _token_stack.push(rhs_token_);
+                        rhs_token_ = _token_arena.create<token>(*iter_);
 
                         if (iter_ + 1 != end_) ++iter_;
 
@@ -152,9 +156,9 @@ namespace lexertl
                             token_._type == token_type::AREPEATN;
                     }) != regex_.cend();
 
-                _node_ptr_vector.push_back(std::make_unique<end_node>
-                    (id_, user_id_, unique_id_, next_dfa_, push_dfa_, pop_dfa_,
-                        non_greedy_ ? greedy_repeat::no : greedy_repeat::yes));
+                root_ = create_node<end_node>(id_, user_id_, unique_id_,
+                    next_dfa_, push_dfa_, pop_dfa_,
+                    non_greedy_ ? greedy_repeat::no : greedy_repeat::yes);
 
                 if (!_tree_node_stack.empty())
                 {
@@ -163,14 +167,12 @@ namespace lexertl
                     observer_ptr<node> lhs_node_ = _tree_node_stack.top();
 
                     _tree_node_stack.pop();
-
-                    observer_ptr<node> rhs_node_ = _node_ptr_vector.back().get();
-
-                    _node_ptr_vector.push_back(std::make_unique<sequence_node>
-                        (lhs_node_, rhs_node_));
+                    root_ = create_node<sequence_node>(lhs_node_, root_);
                 }
 
-                root_ = _node_ptr_vector.back().get();
+                // Every token has been popped, so reuse their memory for
+                // the next regex.
+                _token_arena.clear();
 
                 if (seen_bol_)
                 {
@@ -195,33 +197,49 @@ namespace lexertl
             using range = typename string_token::range;
             using string_token_vector =
                 std::vector<std::unique_ptr<string_token>>;
-            using token_stack = std::stack<std::unique_ptr<token>>;
+            using token_stack = std::stack<observer_ptr<token>,
+                std::vector<observer_ptr<token>>>;
             using tree_node_stack = typename node::node_stack;
 
             const std::locale& _locale;
             node_ptr_vector& _node_ptr_vector;
             charset_map& _charset_map;
             id_type _eoi;
+            // Owns the tokens of the regex being parsed
+            arena _token_arena;
             token_stack _token_stack;
+            // The handle being reduced, kept to reuse its memory
+            token_stack _handle;
             tree_node_stack _tree_node_stack;
 
+            template<typename type, typename... arg_types>
+            observer_ptr<type> create_node(arg_types&&... args_) const
+            {
+                return _node_ptr_vector.template create<type>
+                    (std::forward<arg_types>(args_)...);
+            }
+
             void reduce(id_type& cr_id_, id_type& nl_id_)
             {
                 observer_ptr<token> lhs_ = nullptr;
                 observer_ptr<token> rhs_ = nullptr;
-                token_stack handle_;
+                token_stack& handle_ = _handle;
                 char action_ = 0;
 
+                while (!handle_.empty())
+                {
+                    handle_.pop();
+                }
+
                 do
                 {
-                    handle_.emplace();
-                    rhs_ = _token_stack.top().release();
-                    handle_.top().reset(rhs_);
+                    rhs_ = _token_stack.top();
+                    handle_.push(rhs_);
                     _token_stack.pop();
 
                     if (!_token_stack.empty())
                     {
-                        lhs_ = _token_stack.top().get();
+                        lhs_ = _token_stack.top();
                         action_ = lhs_->precedence(rhs_->_type);
                     }
                 } while (!_token_stack.empty() && action_ == '=');
@@ -240,14 +258,14 @@ namespace lexertl
                     orexp(handle_);
                     break;
                 case token_type::SEQUENCE:
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::OREXP));
                     break;
                 case token_type::SUB:
                     sub(handle_);
                     break;
                 case token_type::EXPRESSION:
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::SUB));
                     break;
                 case token_type::REPEAT:
@@ -270,7 +288,7 @@ namespace lexertl
                     optional(rhs_->_type == token_type::OPT ?
                         greedy_repeat::hard :
                         greedy_repeat::no);
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::DUP));
                     break;
                 case token_type::ZEROORMORE:
@@ -278,7 +296,7 @@ namespace lexertl
                     zero_or_more(rhs_->_type == token_type::ZEROORMORE ?
                         greedy_repeat::hard :
                         greedy_repeat::no);
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::DUP));
                     break;
                 case token_type::ONEORMORE:
@@ -286,7 +304,7 @@ namespace lexertl
                     one_or_more(rhs_->_type == token_type::ONEORMORE ?
                         greedy_repeat::hard :
                         greedy_repeat::no);
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::DUP));
                     break;
                 case token_type::REPEATN:
@@ -294,8 +312,8 @@ namespace lexertl
                     repeatn(rhs_->_type == token_type::REPEATN ?
                         greedy_repeat::hard :
                         greedy_repeat::no,
-                        handle_.top().get());
-                    _token_stack.push(std::make_unique<token>
+                        handle_.top());
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::DUP));
                     break;
                 default:
@@ -312,7 +330,7 @@ namespace lexertl
 
                 if (handle_.size() == 1)
                 {
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::REGEX));
                 }
                 else
@@ -322,7 +340,7 @@ namespace lexertl
                     handle_.pop();
                     assert(handle_.top()->_type == token_type::SEQUENCE);
                     perform_or();
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::OREXP));
                 }
             }
@@ -336,9 +354,8 @@ namespace lexertl
 
                 observer_ptr<node> lhs_ = _tree_node_stack.top();
 
-                _node_ptr_vector.push_back
-                (std::make_unique<selection_node>(lhs_, rhs_));
-                _tree_node_stack.top() = _node_ptr_vector.back().get();
+                _tree_node_stack.top() = create_node<selection_node>
+                    (lhs_, rhs_);
             }
 
             void sub(token_stack& handle_)
@@ -348,7 +365,7 @@ namespace lexertl
 
                 if (handle_.size() == 1)
                 {
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::SEQUENCE));
                 }
                 else
@@ -357,7 +374,7 @@ namespace lexertl
                     assert(handle_.top()->_type == token_type::EXPRESSION);
                     // perform join
                     sequence();
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::SUB));
                 }
             }
@@ -369,14 +386,14 @@ namespace lexertl
 
                 if (handle_.size() == 1)
                 {
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::EXPRESSION));
                 }
                 else
                 {
                     handle_.pop();
                     assert(handle_.top()->_type == token_type::DUP);
-                    _token_stack.push(std::make_unique<token>
+                    _token_stack.push(_token_arena.create<token>
                         (token_type::REPEAT));
                 }
             }
@@ -391,10 +408,9 @@ namespace lexertl
                     handle_.size() == 1);
 
                 // store charset
-                _node_ptr_vector.push_back(std::make_unique<leaf_node>
+                _tree_node_stack.push(create_node<leaf_node>
                     (bol_token(), greedy_repeat::yes));
-                _tree_node_stack.push(_node_ptr_vector.back().get());
-                _token_stack.push(std::make_unique<token>
+                _token_stack.push(_token_arena.create<token>
                     (token_type::REPEAT));
             }
 
@@ -423,10 +439,9 @@ namespace lexertl
                 }
 
                 // store charset
-                _node_ptr_vector.push_back(std::make_unique<leaf_node>
+                _tree_node_stack.push(create_node<leaf_node>
                     (eol_token(), greedy_repeat::yes));
-                _tree_node_stack.push(_node_ptr_vector.back().get());
-                _token_stack.push(std::make_unique<token>
+                _token_stack.push(_token_arena.create<token>
                     (token_type::REPEAT));
             }
 
@@ -439,10 +454,9 @@ namespace lexertl
                 const id_type id_ = lookup(handle_.top()->_str);
 
                 // store charset
-                _node_ptr_vector.push_back(std::make_unique<leaf_node>
+                _tree_node_stack.push(create_node<leaf_node>
                     (id_, greedy_repeat::yes));
-                _tree_node_stack.push(_node_ptr_vector.back().get());
-                _token_stack.push(std::make_unique<token>
+                _token_stack.push(_token_arena.create<token>
                     (token_type::REPEAT));
             }
 
@@ -452,14 +466,16 @@ namespace lexertl
                 assert(handle_.top()->_type == token_type::CHARSET &&
                     handle_.size() == 1);
 
-                std::unique_ptr<token> token_(handle_.top().release());
+                observer_ptr<const token> token_ = handle_.top();
 
                 handle_.pop();
-                create_sequence(token_);
+                create_sequence(token_,
+                    std::integral_constant<bool, +sm_traits::utf8>());
             }
 
             // Slice wchar_t into sequence of char.
-            void create_sequence(std::unique_ptr<token>& token_)
+            void create_sequence(observer_ptr<const token> token_,
+                const std::false_type&)
             {
                 string_token_vector data_[+sm_traits::char_24_bit ? 3 : 2];
 
@@ -472,14 +488,186 @@ namespace lexertl
                 push_ranges(data_, std::integral_constant<bool,
                     +sm_traits::char_24_bit>());
 
-                _token_stack.push(std::make_unique<token>
+                _token_stack.push(_token_arena.create<token>
                     (token_type::OPENPAREN));
-                _token_stack.push(std::make_unique<token>
+                _token_stack.push(_token_arena.create<token>
                     (token_type::REGEX));
-                _token_stack.push(std::make_unique<token>
+                _token_stack.push(_token_arena.create<token>
                     (token_type::CLOSEPAREN));
             }
 
+            // Encode the code points as UTF-8 byte sequences, so that the
+            // state machine reads UTF-8 input a byte at a time.
+            void create_sequence(observer_ptr<const token> token_,
+                const std::true_type&)
+            {
+                std::vector<string_token_vector> seqs_;
+
+                for (const input_range& range_ : token_->_str._ranges)
+                {
+                    slice_utf8(static_cast<std::uint32_t>(range_.first),
+                        std::min(static_cast<std::uint32_t>(range_.second),
+                            static_cast<std::uint32_t>(0x10ffff)), seqs_);
+                }
+
+                if (seqs_.empty())
+                {
+                    // Only surrogates, which never match.
+                    const string_token empty_;
+
+                    push_range(&empty_);
+                }
+
+                for (std::size_t i_ = 0, size_ = seqs_.size(); i_ < size_;
+                    ++i_)
+                {
+                    const string_token_vector& seq_ = seqs_[i_];
+
+                    push_range(seq_.front().get());
+
+                    for (std::size_t j_ = 1, len_ = seq_.size(); j_ < len_;
+                        ++j_)
+                    {
+                        push_range(seq_[j_].get());
+                        sequence();
+                    }
+
+                    if (i_ > 0)
+                    {
+                        perform_or();
+                    }
+                }
+
+                _token_stack.push(_token_arena.create<token>
+                    (token_type::OPENPAREN));
+                _token_stack.push(_token_arena.create<token>
+                    (token_type::REGEX));
+                _token_stack.push(_token_arena.create<token>
+                    (token_type::CLOSEPAREN));
+            }
+
+            // Split [first_, second_] until each part is encoded by byte
+            // sequences of the same length whose bytes range independently,
+            // then append one sequence of byte ranges for each part. A
+            // sequence that only differs from an existing one in its last
+            // byte is merged into it.
+            void slice_utf8(const std::uint32_t first_,
+                const std::uint32_t second_,
+                std::vector<string_token_vector>& seqs_) const
+            {
+                static const std::uint32_t max_[] = { 0x7f, 0x7ff, 0xffff };
+
+                if (first_ > second_)
+                    return;
+
+                // Surrogates have no UTF-8 encoding
+                if (first_ <= 0xdfff && second_ >= 0xd800)
+                {
+                    if (first_ < 0xd800)
+                        slice_utf8(first_, 0xd7ff, seqs_);
+
+                    if (second_ > 0xdfff)
+                        slice_utf8(0xe000, second_, seqs_);
+
+                    return;
+                }
+
+                for (const std::uint32_t m_ : max_)
+                {
+                    if (first_ <= m_ && second_ > m_)
+                    {
+                        slice_utf8(first_, m_, seqs_);
+                        slice_utf8(m_ + 1, second_, seqs_);
+                        return;
+                    }
+                }
+
+                for (std::size_t i_ = 1; i_ < 4 && second_ > 0x7f; ++i_)
+                {
+                    const std::uint32_t mask_ = (1U << (6 * i_)) - 1;
+
+                    if ((first_ & ~mask_) != (second_ & ~mask_))
+                    {
+                        if ((first_ & mask_) != 0)
+                        {
+                            slice_utf8(first_, first_ | mask_, seqs_);
+                            slice_utf8((first_ | mask_) + 1, second_, seqs_);
+                            return;
+                        }
+
+                        if ((second_ & mask_) != mask_)
+                        {
+                            slice_utf8(first_, (second_ & ~mask_) - 1, seqs_);
+                            slice_utf8(second_ & ~mask_, second_, seqs_);
+                            return;
+                        }
+                    }
+                }
+
+                unsigned char lhs_[4];
+                unsigned char rhs_[4];
+                const std::size_t len_ = encode_utf8(first_, lhs_);
+                string_token_vector seq_;
+
+                encode_utf8(second_, rhs_);
+
+                for (std::size_t i_ = 0; i_ < len_; ++i_)
+                {
+                    seq_.push_back(std::make_unique<string_token>
+                        (lhs_[i_], rhs_[i_]));
+                }
+
+                for (auto& existing_ : seqs_)
+                {
+                    if (existing_.size() == len_ &&
+                        std::equal(existing_.cbegin(), existing_.cend() - 1,
+                            seq_.cbegin(),
+                            [](const std::unique_ptr<string_token>& l_,
+                                const std::unique_ptr<string_token>& r_)
+                            {
+                                return *l_ == *r_;
+                            }))
+                    {
+                        existing_.back()->insert(*seq_.back());
+                        return;
+                    }
+                }
+
+                seqs_.push_back(std::move(seq_));
+            }
+
+            static std::size_t encode_utf8(const std::uint32_t cp_,
+                unsigned char* out_)
+            {
+                if (cp_ < 0x80)
+                {
+                    out_[0] = static_cast<unsigned char>(cp_);
+                    return 1;
+                }
+                else if (cp_ < 0x800)
+                {
+                    out_[0] = static_cast<unsigned char>(0xc0 | (cp_ >> 6));
+                    out_[1] = static_cast<unsigned char>(0x80 | (cp_ & 0x3f));
+                    return 2;
+                }
+                else if (cp_ < 0x10000)
+                {
+                    out_[0] = static_cast<unsigned char>(0xe0 | (cp_ >> 12));
+                    out_[1] = static_cast<unsigned char>
+                        (0x80 | ((cp_ >> 6) & 0x3f));
+                    out_[2] = static_cast<unsigned char>(0x80 | (cp_ & 0x3f));
+                    return 3;
+                }
+
+                out_[0] = static_cast<unsigned char>(0xf0 | (cp_ >> 18));
+                out_[1] = static_cast<unsigned char>
+                    (0x80 | ((cp_ >> 12) & 0x3f));
+                out_[2] = static_cast<unsigned char>
+                    (0x80 | ((cp_ >> 6) & 0x3f));
+                out_[3] = static_cast<unsigned char>(0x80 | (cp_ & 0x3f));
+                return 4;
+            }
+
             // 16 bit unicode
             void slice_range(const input_range& range_,
                 string_token_vector data_[2], const std::false_type&)
@@ -733,9 +921,8 @@ namespace lexertl
             {
                 const id_type id_ = lookup(*token_);
 
-                _node_ptr_vector.push_back(std::make_unique
-                    <leaf_node>(id_, greedy_repeat::yes));
-                _tree_node_stack.push(_node_ptr_vector.back().get());
+                _tree_node_stack.push(create_node<leaf_node>
+                    (id_, greedy_repeat::yes));
             }
 
             id_type lookup(const string_token& charset_)
@@ -774,7 +961,8 @@ namespace lexertl
                 assert(handle_.top()->_type == token_type::REGEX);
                 handle_.pop();
                 assert(handle_.top()->_type == token_type::CLOSEPAREN);
-                _token_stack.push(std::make_unique<token>(token_type::REPEAT));
+                _token_stack.push(_token_arena.create<token>
+                    (token_type::REPEAT));
             }
 
             void sequence()
@@ -785,9 +973,7 @@ namespace lexertl
 
                 observer_ptr<node> lhs_ = _tree_node_stack.top();
 
-                _node_ptr_vector.push_back(std::make_unique<sequence_node>
-                    (lhs_, rhs_));
-                _tree_node_stack.top() = _node_ptr_vector.back().get();
+                _tree_node_stack.top() = create_node<sequence_node>(lhs_, rhs_);
             }
 
             void optional(const greedy_repeat greedy_)
@@ -803,14 +989,11 @@ namespace lexertl
                     node_->greedy(greedy_);
                 }
 
-                _node_ptr_vector.push_back(std::make_unique<leaf_node>
-                    (node::null_token(), greedy_));
-
-                observer_ptr<node> rhs_ = _node_ptr_vector.back().get();
+                observer_ptr<node> rhs_ = create_node<leaf_node>
+                    (node::null_token(), greedy_);
 
-                _node_ptr_vector.push_back(std::make_unique<selection_node>
-                    (lhs_, rhs_));
-                _tree_node_stack.top() = _node_ptr_vector.back().get();
+                _tree_node_stack.top() = create_node<selection_node>
+                    (lhs_, rhs_);
             }
 
             void zero_or_more(const greedy_repeat greedy_)
@@ -818,9 +1001,8 @@ namespace lexertl
                 // perform *
                 observer_ptr<node> ptr_ = _tree_node_stack.top();
 
-                _node_ptr_vector.push_back(std::make_unique<iteration_node>
-                    (ptr_, greedy_));
-                _tree_node_stack.top() = _node_ptr_vector.back().get();
+                _tree_node_stack.top() = create_node<iteration_node>
+                    (ptr_, greedy_);
             }
 
             void one_or_more(const greedy_repeat greedy_)
@@ -829,14 +1011,10 @@ namespace lexertl
                 observer_ptr<node> lhs_ = _tree_node_stack.top();
                 observer_ptr<node> copy_ = lhs_->copy(_node_ptr_vector);
 
-                _node_ptr_vector.push_back(std::make_unique<iteration_node>
-                    (copy_, greedy_));
-
-                observer_ptr<node> rhs_ = _node_ptr_vector.back().get();
+                observer_ptr<node> rhs_ = create_node<iteration_node>
+                    (copy_, greedy_);
 
-                _node_ptr_vector.push_back(std::make_unique<sequence_node>
-                    (lhs_, rhs_));
-                _tree_node_stack.top() = _node_ptr_vector.back().get();
+                _tree_node_stack.top() = create_node<sequence_node>(lhs_, rhs_);
             }
 
             // perform {n[,[m]]}
@@ -948,23 +1126,15 @@ namespace lexertl
 
                 if (!found_)
                 {
-                    _node_ptr_vector.push_back(std::make_unique<leaf_node>
-                        (bol_token(), greedy_repeat::yes));
-
-                    observer_ptr<node> lhs_ = _node_ptr_vector.back().get();
-
-                    _node_ptr_vector.push_back(std::make_unique<leaf_node>
-                        (node::null_token(), greedy_repeat::yes));
+                    observer_ptr<node> lhs_ = create_node<leaf_node>
+                        (bol_token(), greedy_repeat::yes);
 
-                    observer_ptr<node> rhs_ = _node_ptr_vector.back().get();
+                    observer_ptr<node> rhs_ = create_node<leaf_node>
+                        (node::null_token(), greedy_repeat::yes);
 
-                    _node_ptr_vector.push_back(std::make_unique<selection_node>
-                        (lhs_, rhs_));
-                    lhs_ = _node_ptr_vector.back().get();
+                    lhs_ = create_node<selection_node>(lhs_, rhs_);
 
-                    _node_ptr_vector.push_back(std::make_unique<sequence_node>
-                        (lhs_, root_));
-                    root_ = _node_ptr_vector.back().get();
+                    root_ = create_node<sequence_node>(lhs_, root_);
                 }
             }
         };
@@ -1,1690 +0,0 @@
-
-    static const char* InBasic_Latin()
-    {
-        return "[\\x0000-\\x007F]";
-    }
-
-    static const char* InLatin_1_Supplement()
-    {
-        return "[\\x0080-\\x00FF]";
-    }
-
-    static const char* InLatin_Extended_A()
-    {
-        return "[\\x0100-\\x017F]";
-    }
-
-    static const char* InLatin_Extended_B()
-    {
-        return "[\\x0180-\\x024F]";
-    }
-
-    static const char* InIPA_Extensions()
-    {
-        return "[\\x0250-\\x02AF]";
-    }
-
-    static const char* InSpacing_Modifier_Letters()
-    {
-        return "[\\x02B0-\\x02FF]";
-    }
-
-    static const char* InCombining_Diacritical_Marks()
-    {
-        return "[\\x0300-\\x036F]";
-    }
-
-    static const char* InGreek_and_Coptic()
-    {
-        return "[\\x0370-\\x03FF]";
-    }
-
-    static const char* InCyrillic()
-    {
-        return "[\\x0400-\\x04FF]";
-    }
-
-    static const char* InCyrillic_Supplement()
-    {
-        return "[\\x0500-\\x052F]";
-    }
-
-    static const char* InArmenian()
-    {
-        return "[\\x0530-\\x058F]";
-    }
-
-    static const char* InHebrew()
-    {
-        return "[\\x0590-\\x05FF]";
-    }
-
-    static const char* InArabic()
-    {
-        return "[\\x0600-\\x06FF]";
-    }
-
-    static const char* InSyriac()
-    {
-        return "[\\x0700-\\x074F]";
-    }
-
-    static const char* InArabic_Supplement()
-    {
-        return "[\\x0750-\\x077F]";
-    }
-
-    static const char* InThaana()
-    {
-        return "[\\x0780-\\x07BF]";
-    }
-
-    static const char* InNKo()
-    {
-        return "[\\x07C0-\\x07FF]";
-    }
-
-    static const char* InSamaritan()
-    {
-        return "[\\x0800-\\x083F]";
-    }
-
-    static const char* InMandaic()
-    {
-        return "[\\x0840-\\x085F]";
-    }
-
-    static const char* InSyriac_Supplement()
-    {
-        return "[\\x0860-\\x086F]";
-    }
-
-    static const char* InArabic_Extended_B()
-    {
-        return "[\\x0870-\\x089F]";
-    }
-
-    static const char* InArabic_Extended_A()
-    {
-        return "[\\x08A0-\\x08FF]";
-    }
-
-    static const char* InDevanagari()
-    {
-        return "[\\x0900-\\x097F]";
-    }
-
-    static const char* InBengali()
-    {
-        return "[\\x0980-\\x09FF]";
-    }
-
-    static const char* InGurmukhi()
-    {
-        return "[\\x0A00-\\x0A7F]";
-    }
-
-    static const char* InGujarati()
-    {
-        return "[\\x0A80-\\x0AFF]";
-    }
-
-    static const char* InOriya()
-    {
-        return "[\\x0B00-\\x0B7F]";
-    }
-
-    static const char* InTamil()
-    {
-        return "[\\x0B80-\\x0BFF]";
-    }
-
-    static const char* InTelugu()
-    {
-        return "[\\x0C00-\\x0C7F]";
-    }
-
-    static const char* InKannada()
-    {
-        return "[\\x0C80-\\x0CFF]";
-    }
-
-    static const char* InMalayalam()
-    {
-        return "[\\x0D00-\\x0D7F]";
-    }
-
-    static const char* InSinhala()
-    {
-        return "[\\x0D80-\\x0DFF]";
-    }
-
-    static const char* InThai()
-    {
-        return "[\\x0E00-\\x0E7F]";
-    }
-
-    static const char* InLao()
-    {
-        return "[\\x0E80-\\x0EFF]";
-    }
-
-    static const char* InTibetan()
-    {
-        return "[\\x0F00-\\x0FFF]";
-    }
-
-    static const char* InMyanmar()
-    {
-        return "[\\x1000-\\x109F]";
-    }
-
-    static const char* InGeorgian()
-    {
-        return "[\\x10A0-\\x10FF]";
-    }
-
-    static const char* InHangul_Jamo()
-    {
-        return "[\\x1100-\\x11FF]";
-    }
-
-    static const char* InEthiopic()
-    {
-        return "[\\x1200-\\x137F]";
-    }
-
-    static const char* InEthiopic_Supplement()
-    {
-        return "[\\x1380-\\x139F]";
-    }
-
-    static const char* InCherokee()
-    {
-        return "[\\x13A0-\\x13FF]";
-    }
-
-    static const char* InUnified_Canadian_Aboriginal_Syllabics()
-    {
-        return "[\\x1400-\\x167F]";
-    }
-
-    static const char* InOgham()
-    {
-        return "[\\x1680-\\x169F]";
-    }
-
-    static const char* InRunic()
-    {
-        return "[\\x16A0-\\x16FF]";
-    }
-
-    static const char* InTagalog()
-    {
-        return "[\\x1700-\\x171F]";
-    }
-
-    static const char* InHanunoo()
-    {
-        return "[\\x1720-\\x173F]";
-    }
-
-    static const char* InBuhid()
-    {
-        return "[\\x1740-\\x175F]";
-    }
-
-    static const char* InTagbanwa()
-    {
-        return "[\\x1760-\\x177F]";
-    }
-
-    static const char* InKhmer()
-    {
-        return "[\\x1780-\\x17FF]";
-    }
-
-    static const char* InMongolian()
-    {
-        return "[\\x1800-\\x18AF]";
-    }
-
-    static const char* InUnified_Canadian_Aboriginal_Syllabics_Extended()
-    {
-        return "[\\x18B0-\\x18FF]";
-    }
-
-    static const char* InLimbu()
-    {
-        return "[\\x1900-\\x194F]";
-    }
-
-    static const char* InTai_Le()
-    {
-        return "[\\x1950-\\x197F]";
-    }
-
-    static const char* InNew_Tai_Lue()
-    {
-        return "[\\x1980-\\x19DF]";
-    }
-
-    static const char* InKhmer_Symbols()
-    {
-        return "[\\x19E0-\\x19FF]";
-    }
-
-    static const char* InBuginese()
-    {
-        return "[\\x1A00-\\x1A1F]";
-    }
-
-    static const char* InTai_Tham()
-    {
-        return "[\\x1A20-\\x1AAF]";
-    }
-
-    static const char* InCombining_Diacritical_Marks_Extended()
-    {
-        return "[\\x1AB0-\\x1AFF]";
-    }
-
-    static const char* InBalinese()
-    {
-        return "[\\x1B00-\\x1B7F]";
-    }
-
-    static const char* InSundanese()
-    {
-        return "[\\x1B80-\\x1BBF]";
-    }
-
-    static const char* InBatak()
-    {
-        return "[\\x1BC0-\\x1BFF]";
-    }
-
-    static const char* InLepcha()
-    {
-        return "[\\x1C00-\\x1C4F]";
-    }
-
-    static const char* InOl_Chiki()
-    {
-        return "[\\x1C50-\\x1C7F]";
-    }
-
-    static const char* InCyrillic_Extended_C()
-    {
-        return "[\\x1C80-\\x1C8F]";
-    }
-
-    static const char* InGeorgian_Extended()
-    {
-        return "[\\x1C90-\\x1CBF]";
-    }
-
-    static const char* InSundanese_Supplement()
-    {
-        return "[\\x1CC0-\\x1CCF]";
-    }
-
-    static const char* InVedic_Extensions()
-    {
-        return "[\\x1CD0-\\x1CFF]";
-    }
-
-    static const char* InPhonetic_Extensions()
-    {
-        return "[\\x1D00-\\x1D7F]";
-    }
-
-    static const char* InPhonetic_Extensions_Supplement()
-    {
-        return "[\\x1D80-\\x1DBF]";
-    }
-
-    static const char* InCombining_Diacritical_Marks_Supplement()
-    {
-        return "[\\x1DC0-\\x1DFF]";
-    }
-
-    static const char* InLatin_Extended_Additional()
-    {
-        return "[\\x1E00-\\x1EFF]";
-    }
-
-    static const char* InGreek_Extended()
-    {
-        return "[\\x1F00-\\x1FFF]";
-    }
-
-    static const char* InGeneral_Punctuation()
-    {
-        return "[\\x2000-\\x206F]";
-    }
-
-    static const char* InSuperscripts_and_Subscripts()
-    {
-        return "[\\x2070-\\x209F]";
-    }
-
-    static const char* InCurrency_Symbols()
-    {
-        return "[\\x20A0-\\x20CF]";
-    }
-
-    static const char* InCombining_Diacritical_Marks_for_Symbols()
-    {
-        return "[\\x20D0-\\x20FF]";
-    }
-
-    static const char* InLetterlike_Symbols()
-    {
-        return "[\\x2100-\\x214F]";
-    }
-
-    static const char* InNumber_Forms()
-    {
-        return "[\\x2150-\\x218F]";
-    }
-
-    static const char* InArrows()
-    {
-        return "[\\x2190-\\x21FF]";
-    }
-
-    static const char* InMathematical_Operators()
-    {
-        return "[\\x2200-\\x22FF]";
-    }
-
-    static const char* InMiscellaneous_Technical()
-    {
-        return "[\\x2300-\\x23FF]";
-    }
-
-    static const char* InControl_Pictures()
-    {
-        return "[\\x2400-\\x243F]";
-    }
-
-    static const char* InOptical_Character_Recognition()
-    {
-        return "[\\x2440-\\x245F]";
-    }
-
-    static const char* InEnclosed_Alphanumerics()
-    {
-        return "[\\x2460-\\x24FF]";
-    }
-
-    static const char* InBox_Drawing()
-    {
-        return "[\\x2500-\\x257F]";
-    }
-
-    static const char* InBlock_Elements()
-    {
-        return "[\\x2580-\\x259F]";
-    }
-
-    static const char* InGeometric_Shapes()
-    {
-        return "[\\x25A0-\\x25FF]";
-    }
-
-    static const char* InMiscellaneous_Symbols()
-    {
-        return "[\\x2600-\\x26FF]";
-    }
-
-    static const char* InDingbats()
-    {
-        return "[\\x2700-\\x27BF]";
-    }
-
-    static const char* InMiscellaneous_Mathematical_Symbols_A()
-    {
-        return "[\\x27C0-\\x27EF]";
-    }
-
-    static const char* InSupplemental_Arrows_A()
-    {
-        return "[\\x27F0-\\x27FF]";
-    }
-
-    static const char* InBraille_Patterns()
-    {
-        return "[\\x2800-\\x28FF]";
-    }
-
-    static const char* InSupplemental_Arrows_B()
-    {
-        return "[\\x2900-\\x297F]";
-    }
-
-    static const char* InMiscellaneous_Mathematical_Symbols_B()
-    {
-        return "[\\x2980-\\x29FF]";
-    }
-
-    static const char* InSupplemental_Mathematical_Operators()
-    {
-        return "[\\x2A00-\\x2AFF]";
-    }
-
-    static const char* InMiscellaneous_Symbols_and_Arrows()
-    {
-        return "[\\x2B00-\\x2BFF]";
-    }
-
-    static const char* InGlagolitic()
-    {
-        return "[\\x2C00-\\x2C5F]";
-    }
-
-    static const char* InLatin_Extended_C()
-    {
-        return "[\\x2C60-\\x2C7F]";
-    }
-
-    static const char* InCoptic()
-    {
-        return "[\\x2C80-\\x2CFF]";
-    }
-
-    static const char* InGeorgian_Supplement()
-    {
-        return "[\\x2D00-\\x2D2F]";
-    }
-
-    static const char* InTifinagh()
-    {
-        return "[\\x2D30-\\x2D7F]";
-    }
-
-    static const char* InEthiopic_Extended()
-    {
-        return "[\\x2D80-\\x2DDF]";
-    }
-
-    static const char* InCyrillic_Extended_A()
-    {
-        return "[\\x2DE0-\\x2DFF]";
-    }
-
-    static const char* InSupplemental_Punctuation()
-    {
-        return "[\\x2E00-\\x2E7F]";
-    }
-
-    static const char* InCJK_Radicals_Supplement()
-    {
-        return "[\\x2E80-\\x2EFF]";
-    }
-
-    static const char* InKangxi_Radicals()
-    {
-        return "[\\x2F00-\\x2FDF]";
-    }
-
-    static const char* InIdeographic_Description_Characters()
-    {
-        return "[\\x2FF0-\\x2FFF]";
-    }
-
-    static const char* InCJK_Symbols_and_Punctuation()
-    {
-        return "[\\x3000-\\x303F]";
-    }
-
-    static const char* InHiragana()
-    {
-        return "[\\x3040-\\x309F]";
-    }
-
-    static const char* InKatakana()
-    {
-        return "[\\x30A0-\\x30FF]";
-    }
-
-    static const char* InBopomofo()
-    {
-        return "[\\x3100-\\x312F]";
-    }
-
-    static const char* InHangul_Compatibility_Jamo()
-    {
-        return "[\\x3130-\\x318F]";
-    }
-
-    static const char* InKanbun()
-    {
-        return "[\\x3190-\\x319F]";
-    }
-
-    static const char* InBopomofo_Extended()
-    {
-        return "[\\x31A0-\\x31BF]";
-    }
-
-    static const char* InCJK_Strokes()
-    {
-        return "[\\x31C0-\\x31EF]";
-    }
-
-    static const char* InKatakana_Phonetic_Extensions()
-    {
-        return "[\\x31F0-\\x31FF]";
-    }
-
-    static const char* InEnclosed_CJK_Letters_and_Months()
-    {
-        return "[\\x3200-\\x32FF]";
-    }
-
-    static const char* InCJK_Compatibility()
-    {
-        return "[\\x3300-\\x33FF]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_A()
-    {
-        return "[\\x3400-\\x4DBF]";
-    }
-
-    static const char* InYijing_Hexagram_Symbols()
-    {
-        return "[\\x4DC0-\\x4DFF]";
-    }
-
-    static const char* InCJK_Unified_Ideographs()
-    {
-        return "[\\x4E00-\\x9FFF]";
-    }
-
-    static const char* InYi_Syllables()
-    {
-        return "[\\xA000-\\xA48F]";
-    }
-
-    static const char* InYi_Radicals()
-    {
-        return "[\\xA490-\\xA4CF]";
-    }
-
-    static const char* InLisu()
-    {
-        return "[\\xA4D0-\\xA4FF]";
-    }
-
-    static const char* InVai()
-    {
-        return "[\\xA500-\\xA63F]";
-    }
-
-    static const char* InCyrillic_Extended_B()
-    {
-        return "[\\xA640-\\xA69F]";
-    }
-
-    static const char* InBamum()
-    {
-        return "[\\xA6A0-\\xA6FF]";
-    }
-
-    static const char* InModifier_Tone_Letters()
-    {
-        return "[\\xA700-\\xA71F]";
-    }
-
-    static const char* InLatin_Extended_D()
-    {
-        return "[\\xA720-\\xA7FF]";
-    }
-
-    static const char* InSyloti_Nagri()
-    {
-        return "[\\xA800-\\xA82F]";
-    }
-
-    static const char* InCommon_Indic_Number_Forms()
-    {
-        return "[\\xA830-\\xA83F]";
-    }
-
-    static const char* InPhags_pa()
-    {
-        return "[\\xA840-\\xA87F]";
-    }
-
-    static const char* InSaurashtra()
-    {
-        return "[\\xA880-\\xA8DF]";
-    }
-
-    static const char* InDevanagari_Extended()
-    {
-        return "[\\xA8E0-\\xA8FF]";
-    }
-
-    static const char* InKayah_Li()
-    {
-        return "[\\xA900-\\xA92F]";
-    }
-
-    static const char* InRejang()
-    {
-        return "[\\xA930-\\xA95F]";
-    }
-
-    static const char* InHangul_Jamo_Extended_A()
-    {
-        return "[\\xA960-\\xA97F]";
-    }
-
-    static const char* InJavanese()
-    {
-        return "[\\xA980-\\xA9DF]";
-    }
-
-    static const char* InMyanmar_Extended_B()
-    {
-        return "[\\xA9E0-\\xA9FF]";
-    }
-
-    static const char* InCham()
-    {
-        return "[\\xAA00-\\xAA5F]";
-    }
-
-    static const char* InMyanmar_Extended_A()
-    {
-        return "[\\xAA60-\\xAA7F]";
-    }
-
-    static const char* InTai_Viet()
-    {
-        return "[\\xAA80-\\xAADF]";
-    }
-
-    static const char* InMeetei_Mayek_Extensions()
-    {
-        return "[\\xAAE0-\\xAAFF]";
-    }
-
-    static const char* InEthiopic_Extended_A()
-    {
-        return "[\\xAB00-\\xAB2F]";
-    }
-
-    static const char* InLatin_Extended_E()
-    {
-        return "[\\xAB30-\\xAB6F]";
-    }
-
-    static const char* InCherokee_Supplement()
-    {
-        return "[\\xAB70-\\xABBF]";
-    }
-
-    static const char* InMeetei_Mayek()
-    {
-        return "[\\xABC0-\\xABFF]";
-    }
-
-    static const char* InHangul_Syllables()
-    {
-        return "[\\xAC00-\\xD7AF]";
-    }
-
-    static const char* InHangul_Jamo_Extended_B()
-    {
-        return "[\\xD7B0-\\xD7FF]";
-    }
-
-    static const char* InHigh_Surrogates()
-    {
-        return "[\\xD800-\\xDB7F]";
-    }
-
-    static const char* InHigh_Private_Use_Surrogates()
-    {
-        return "[\\xDB80-\\xDBFF]";
-    }
-
-    static const char* InLow_Surrogates()
-    {
-        return "[\\xDC00-\\xDFFF]";
-    }
-
-    static const char* InPrivate_Use_Area()
-    {
-        return "[\\xE000-\\xF8FF]";
-    }
-
-    static const char* InCJK_Compatibility_Ideographs()
-    {
-        return "[\\xF900-\\xFAFF]";
-    }
-
-    static const char* InAlphabetic_Presentation_Forms()
-    {
-        return "[\\xFB00-\\xFB4F]";
-    }
-
-    static const char* InArabic_Presentation_Forms_A()
-    {
-        return "[\\xFB50-\\xFDFF]";
-    }
-
-    static const char* InVariation_Selectors()
-    {
-        return "[\\xFE00-\\xFE0F]";
-    }
-
-    static const char* InVertical_Forms()
-    {
-        return "[\\xFE10-\\xFE1F]";
-    }
-
-    static const char* InCombining_Half_Marks()
-    {
-        return "[\\xFE20-\\xFE2F]";
-    }
-
-    static const char* InCJK_Compatibility_Forms()
-    {
-        return "[\\xFE30-\\xFE4F]";
-    }
-
-    static const char* InSmall_Form_Variants()
-    {
-        return "[\\xFE50-\\xFE6F]";
-    }
-
-    static const char* InArabic_Presentation_Forms_B()
-    {
-        return "[\\xFE70-\\xFEFF]";
-    }
-
-    static const char* InHalfwidth_and_Fullwidth_Forms()
-    {
-        return "[\\xFF00-\\xFFEF]";
-    }
-
-    static const char* InSpecials()
-    {
-        return "[\\xFFF0-\\xFFFF]";
-    }
-
-    static const char* InLinear_B_Syllabary()
-    {
-        return "[\\x10000-\\x1007F]";
-    }
-
-    static const char* InLinear_B_Ideograms()
-    {
-        return "[\\x10080-\\x100FF]";
-    }
-
-    static const char* InAegean_Numbers()
-    {
-        return "[\\x10100-\\x1013F]";
-    }
-
-    static const char* InAncient_Greek_Numbers()
-    {
-        return "[\\x10140-\\x1018F]";
-    }
-
-    static const char* InAncient_Symbols()
-    {
-        return "[\\x10190-\\x101CF]";
-    }
-
-    static const char* InPhaistos_Disc()
-    {
-        return "[\\x101D0-\\x101FF]";
-    }
-
-    static const char* InLycian()
-    {
-        return "[\\x10280-\\x1029F]";
-    }
-
-    static const char* InCarian()
-    {
-        return "[\\x102A0-\\x102DF]";
-    }
-
-    static const char* InCoptic_Epact_Numbers()
-    {
-        return "[\\x102E0-\\x102FF]";
-    }
-
-    static const char* InOld_Italic()
-    {
-        return "[\\x10300-\\x1032F]";
-    }
-
-    static const char* InGothic()
-    {
-        return "[\\x10330-\\x1034F]";
-    }
-
-    static const char* InOld_Permic()
-    {
-        return "[\\x10350-\\x1037F]";
-    }
-
-    static const char* InUgaritic()
-    {
-        return "[\\x10380-\\x1039F]";
-    }
-
-    static const char* InOld_Persian()
-    {
-        return "[\\x103A0-\\x103DF]";
-    }
-
-    static const char* InDeseret()
-    {
-        return "[\\x10400-\\x1044F]";
-    }
-
-    static const char* InShavian()
-    {
-        return "[\\x10450-\\x1047F]";
-    }
-
-    static const char* InOsmanya()
-    {
-        return "[\\x10480-\\x104AF]";
-    }
-
-    static const char* InOsage()
-    {
-        return "[\\x104B0-\\x104FF]";
-    }
-
-    static const char* InElbasan()
-    {
-        return "[\\x10500-\\x1052F]";
-    }
-
-    static const char* InCaucasian_Albanian()
-    {
-        return "[\\x10530-\\x1056F]";
-    }
-
-    static const char* InVithkuqi()
-    {
-        return "[\\x10570-\\x105BF]";
-    }
-
-    static const char* InTodhri()
-    {
-        return "[\\x105C0-\\x105FF]";
-    }
-
-    static const char* InLinear_A()
-    {
-        return "[\\x10600-\\x1077F]";
-    }
-
-    static const char* InLatin_Extended_F()
-    {
-        return "[\\x10780-\\x107BF]";
-    }
-
-    static const char* InCypriot_Syllabary()
-    {
-        return "[\\x10800-\\x1083F]";
-    }
-
-    static const char* InImperial_Aramaic()
-    {
-        return "[\\x10840-\\x1085F]";
-    }
-
-    static const char* InPalmyrene()
-    {
-        return "[\\x10860-\\x1087F]";
-    }
-
-    static const char* InNabataean()
-    {
-        return "[\\x10880-\\x108AF]";
-    }
-
-    static const char* InHatran()
-    {
-        return "[\\x108E0-\\x108FF]";
-    }
-
-    static const char* InPhoenician()
-    {
-        return "[\\x10900-\\x1091F]";
-    }
-
-    static const char* InLydian()
-    {
-        return "[\\x10920-\\x1093F]";
-    }
-
-    static const char* InMeroitic_Hieroglyphs()
-    {
-        return "[\\x10980-\\x1099F]";
-    }
-
-    static const char* InMeroitic_Cursive()
-    {
-        return "[\\x109A0-\\x109FF]";
-    }
-
-    static const char* InKharoshthi()
-    {
-        return "[\\x10A00-\\x10A5F]";
-    }
-
-    static const char* InOld_South_Arabian()
-    {
-        return "[\\x10A60-\\x10A7F]";
-    }
-
-    static const char* InOld_North_Arabian()
-    {
-        return "[\\x10A80-\\x10A9F]";
-    }
-
-    static const char* InManichaean()
-    {
-        return "[\\x10AC0-\\x10AFF]";
-    }
-
-    static const char* InAvestan()
-    {
-        return "[\\x10B00-\\x10B3F]";
-    }
-
-    static const char* InInscriptional_Parthian()
-    {
-        return "[\\x10B40-\\x10B5F]";
-    }
-
-    static const char* InInscriptional_Pahlavi()
-    {
-        return "[\\x10B60-\\x10B7F]";
-    }
-
-    static const char* InPsalter_Pahlavi()
-    {
-        return "[\\x10B80-\\x10BAF]";
-    }
-
-    static const char* InOld_Turkic()
-    {
-        return "[\\x10C00-\\x10C4F]";
-    }
-
-    static const char* InOld_Hungarian()
-    {
-        return "[\\x10C80-\\x10CFF]";
-    }
-
-    static const char* InHanifi_Rohingya()
-    {
-        return "[\\x10D00-\\x10D3F]";
-    }
-
-    static const char* InGaray()
-    {
-        return "[\\x10D40-\\x10D8F]";
-    }
-
-    static const char* InRumi_Numeral_Symbols()
-    {
-        return "[\\x10E60-\\x10E7F]";
-    }
-
-    static const char* InYezidi()
-    {
-        return "[\\x10E80-\\x10EBF]";
-    }
-
-    static const char* InArabic_Extended_C()
-    {
-        return "[\\x10EC0-\\x10EFF]";
-    }
-
-    static const char* InOld_Sogdian()
-    {
-        return "[\\x10F00-\\x10F2F]";
-    }
-
-    static const char* InSogdian()
-    {
-        return "[\\x10F30-\\x10F6F]";
-    }
-
-    static const char* InOld_Uyghur()
-    {
-        return "[\\x10F70-\\x10FAF]";
-    }
-
-    static const char* InChorasmian()
-    {
-        return "[\\x10FB0-\\x10FDF]";
-    }
-
-    static const char* InElymaic()
-    {
-        return "[\\x10FE0-\\x10FFF]";
-    }
-
-    static const char* InBrahmi()
-    {
-        return "[\\x11000-\\x1107F]";
-    }
-
-    static const char* InKaithi()
-    {
-        return "[\\x11080-\\x110CF]";
-    }
-
-    static const char* InSora_Sompeng()
-    {
-        return "[\\x110D0-\\x110FF]";
-    }
-
-    static const char* InChakma()
-    {
-        return "[\\x11100-\\x1114F]";
-    }
-
-    static const char* InMahajani()
-    {
-        return "[\\x11150-\\x1117F]";
-    }
-
-    static const char* InSharada()
-    {
-        return "[\\x11180-\\x111DF]";
-    }
-
-    static const char* InSinhala_Archaic_Numbers()
-    {
-        return "[\\x111E0-\\x111FF]";
-    }
-
-    static const char* InKhojki()
-    {
-        return "[\\x11200-\\x1124F]";
-    }
-
-    static const char* InMultani()
-    {
-        return "[\\x11280-\\x112AF]";
-    }
-
-    static const char* InKhudawadi()
-    {
-        return "[\\x112B0-\\x112FF]";
-    }
-
-    static const char* InGrantha()
-    {
-        return "[\\x11300-\\x1137F]";
-    }
-
-    static const char* InTulu_Tigalari()
-    {
-        return "[\\x11380-\\x113FF]";
-    }
-
-    static const char* InNewa()
-    {
-        return "[\\x11400-\\x1147F]";
-    }
-
-    static const char* InTirhuta()
-    {
-        return "[\\x11480-\\x114DF]";
-    }
-
-    static const char* InSiddham()
-    {
-        return "[\\x11580-\\x115FF]";
-    }
-
-    static const char* InModi()
-    {
-        return "[\\x11600-\\x1165F]";
-    }
-
-    static const char* InMongolian_Supplement()
-    {
-        return "[\\x11660-\\x1167F]";
-    }
-
-    static const char* InTakri()
-    {
-        return "[\\x11680-\\x116CF]";
-    }
-
-    static const char* InMyanmar_Extended_C()
-    {
-        return "[\\x116D0-\\x116FF]";
-    }
-
-    static const char* InAhom()
-    {
-        return "[\\x11700-\\x1174F]";
-    }
-
-    static const char* InDogra()
-    {
-        return "[\\x11800-\\x1184F]";
-    }
-
-    static const char* InWarang_Citi()
-    {
-        return "[\\x118A0-\\x118FF]";
-    }
-
-    static const char* InDives_Akuru()
-    {
-        return "[\\x11900-\\x1195F]";
-    }
-
-    static const char* InNandinagari()
-    {
-        return "[\\x119A0-\\x119FF]";
-    }
-
-    static const char* InZanabazar_Square()
-    {
-        return "[\\x11A00-\\x11A4F]";
-    }
-
-    static const char* InSoyombo()
-    {
-        return "[\\x11A50-\\x11AAF]";
-    }
-
-    static const char* InUnified_Canadian_Aboriginal_Syllabics_Extended_A()
-    {
-        return "[\\x11AB0-\\x11ABF]";
-    }
-
-    static const char* InPau_Cin_Hau()
-    {
-        return "[\\x11AC0-\\x11AFF]";
-    }
-
-    static const char* InDevanagari_Extended_A()
-    {
-        return "[\\x11B00-\\x11B5F]";
-    }
-
-    static const char* InSunuwar()
-    {
-        return "[\\x11BC0-\\x11BFF]";
-    }
-
-    static const char* InBhaiksuki()
-    {
-        return "[\\x11C00-\\x11C6F]";
-    }
-
-    static const char* InMarchen()
-    {
-        return "[\\x11C70-\\x11CBF]";
-    }
-
-    static const char* InMasaram_Gondi()
-    {
-        return "[\\x11D00-\\x11D5F]";
-    }
-
-    static const char* InGunjala_Gondi()
-    {
-        return "[\\x11D60-\\x11DAF]";
-    }
-
-    static const char* InMakasar()
-    {
-        return "[\\x11EE0-\\x11EFF]";
-    }
-
-    static const char* InKawi()
-    {
-        return "[\\x11F00-\\x11F5F]";
-    }
-
-    static const char* InLisu_Supplement()
-    {
-        return "[\\x11FB0-\\x11FBF]";
-    }
-
-    static const char* InTamil_Supplement()
-    {
-        return "[\\x11FC0-\\x11FFF]";
-    }
-
-    static const char* InCuneiform()
-    {
-        return "[\\x12000-\\x123FF]";
-    }
-
-    static const char* InCuneiform_Numbers_and_Punctuation()
-    {
-        return "[\\x12400-\\x1247F]";
-    }
-
-    static const char* InEarly_Dynastic_Cuneiform()
-    {
-        return "[\\x12480-\\x1254F]";
-    }
-
-    static const char* InCypro_Minoan()
-    {
-        return "[\\x12F90-\\x12FFF]";
-    }
-
-    static const char* InEgyptian_Hieroglyphs()
-    {
-        return "[\\x13000-\\x1342F]";
-    }
-
-    static const char* InEgyptian_Hieroglyph_Format_Controls()
-    {
-        return "[\\x13430-\\x1345F]";
-    }
-
-    static const char* InEgyptian_Hieroglyphs_Extended_A()
-    {
-        return "[\\x13460-\\x143FF]";
-    }
-
-    static const char* InAnatolian_Hieroglyphs()
-    {
-        return "[\\x14400-\\x1467F]";
-    }
-
-    static const char* InGurung_Khema()
-    {
-        return "[\\x16100-\\x1613F]";
-    }
-
-    static const char* InBamum_Supplement()
-    {
-        return "[\\x16800-\\x16A3F]";
-    }
-
-    static const char* InMro()
-    {
-        return "[\\x16A40-\\x16A6F]";
-    }
-
-    static const char* InTangsa()
-    {
-        return "[\\x16A70-\\x16ACF]";
-    }
-
-    static const char* InBassa_Vah()
-    {
-        return "[\\x16AD0-\\x16AFF]";
-    }
-
-    static const char* InPahawh_Hmong()
-    {
-        return "[\\x16B00-\\x16B8F]";
-    }
-
-    static const char* InKirat_Rai()
-    {
-        return "[\\x16D40-\\x16D7F]";
-    }
-
-    static const char* InMedefaidrin()
-    {
-        return "[\\x16E40-\\x16E9F]";
-    }
-
-    static const char* InMiao()
-    {
-        return "[\\x16F00-\\x16F9F]";
-    }
-
-    static const char* InIdeographic_Symbols_and_Punctuation()
-    {
-        return "[\\x16FE0-\\x16FFF]";
-    }
-
-    static const char* InTangut()
-    {
-        return "[\\x17000-\\x187FF]";
-    }
-
-    static const char* InTangut_Components()
-    {
-        return "[\\x18800-\\x18AFF]";
-    }
-
-    static const char* InKhitan_Small_Script()
-    {
-        return "[\\x18B00-\\x18CFF]";
-    }
-
-    static const char* InTangut_Supplement()
-    {
-        return "[\\x18D00-\\x18D7F]";
-    }
-
-    static const char* InKana_Extended_B()
-    {
-        return "[\\x1AFF0-\\x1AFFF]";
-    }
-
-    static const char* InKana_Supplement()
-    {
-        return "[\\x1B000-\\x1B0FF]";
-    }
-
-    static const char* InKana_Extended_A()
-    {
-        return "[\\x1B100-\\x1B12F]";
-    }
-
-    static const char* InSmall_Kana_Extension()
-    {
-        return "[\\x1B130-\\x1B16F]";
-    }
-
-    static const char* InNushu()
-    {
-        return "[\\x1B170-\\x1B2FF]";
-    }
-
-    static const char* InDuployan()
-    {
-        return "[\\x1BC00-\\x1BC9F]";
-    }
-
-    static const char* InShorthand_Format_Controls()
-    {
-        return "[\\x1BCA0-\\x1BCAF]";
-    }
-
-    static const char* InSymbols_for_Legacy_Computing_Supplement()
-    {
-        return "[\\x1CC00-\\x1CEBF]";
-    }
-
-    static const char* InZnamenny_Musical_Notation()
-    {
-        return "[\\x1CF00-\\x1CFCF]";
-    }
-
-    static const char* InByzantine_Musical_Symbols()
-    {
-        return "[\\x1D000-\\x1D0FF]";
-    }
-
-    static const char* InMusical_Symbols()
-    {
-        return "[\\x1D100-\\x1D1FF]";
-    }
-
-    static const char* InAncient_Greek_Musical_Notation()
-    {
-        return "[\\x1D200-\\x1D24F]";
-    }
-
-    static const char* InKaktovik_Numerals()
-    {
-        return "[\\x1D2C0-\\x1D2DF]";
-    }
-
-    static const char* InMayan_Numerals()
-    {
-        return "[\\x1D2E0-\\x1D2FF]";
-    }
-
-    static const char* InTai_Xuan_Jing_Symbols()
-    {
-        return "[\\x1D300-\\x1D35F]";
-    }
-
-    static const char* InCounting_Rod_Numerals()
-    {
-        return "[\\x1D360-\\x1D37F]";
-    }
-
-    static const char* InMathematical_Alphanumeric_Symbols()
-    {
-        return "[\\x1D400-\\x1D7FF]";
-    }
-
-    static const char* InSutton_SignWriting()
-    {
-        return "[\\x1D800-\\x1DAAF]";
-    }
-
-    static const char* InLatin_Extended_G()
-    {
-        return "[\\x1DF00-\\x1DFFF]";
-    }
-
-    static const char* InGlagolitic_Supplement()
-    {
-        return "[\\x1E000-\\x1E02F]";
-    }
-
-    static const char* InCyrillic_Extended_D()
-    {
-        return "[\\x1E030-\\x1E08F]";
-    }
-
-    static const char* InNyiakeng_Puachue_Hmong()
-    {
-        return "[\\x1E100-\\x1E14F]";
-    }
-
-    static const char* InToto()
-    {
-        return "[\\x1E290-\\x1E2BF]";
-    }
-
-    static const char* InWancho()
-    {
-        return "[\\x1E2C0-\\x1E2FF]";
-    }
-
-    static const char* InNag_Mundari()
-    {
-        return "[\\x1E4D0-\\x1E4FF]";
-    }
-
-    static const char* InOl_Onal()
-    {
-        return "[\\x1E5D0-\\x1E5FF]";
-    }
-
-    static const char* InEthiopic_Extended_B()
-    {
-        return "[\\x1E7E0-\\x1E7FF]";
-    }
-
-    static const char* InMende_Kikakui()
-    {
-        return "[\\x1E800-\\x1E8DF]";
-    }
-
-    static const char* InAdlam()
-    {
-        return "[\\x1E900-\\x1E95F]";
-    }
-
-    static const char* InIndic_Siyaq_Numbers()
-    {
-        return "[\\x1EC70-\\x1ECBF]";
-    }
-
-    static const char* InOttoman_Siyaq_Numbers()
-    {
-        return "[\\x1ED00-\\x1ED4F]";
-    }
-
-    static const char* InArabic_Mathematical_Alphabetic_Symbols()
-    {
-        return "[\\x1EE00-\\x1EEFF]";
-    }
-
-    static const char* InMahjong_Tiles()
-    {
-        return "[\\x1F000-\\x1F02F]";
-    }
-
-    static const char* InDomino_Tiles()
-    {
-        return "[\\x1F030-\\x1F09F]";
-    }
-
-    static const char* InPlaying_Cards()
-    {
-        return "[\\x1F0A0-\\x1F0FF]";
-    }
-
-    static const char* InEnclosed_Alphanumeric_Supplement()
-    {
-        return "[\\x1F100-\\x1F1FF]";
-    }
-
-    static const char* InEnclosed_Ideographic_Supplement()
-    {
-        return "[\\x1F200-\\x1F2FF]";
-    }
-
-    static const char* InMiscellaneous_Symbols_and_Pictographs()
-    {
-        return "[\\x1F300-\\x1F5FF]";
-    }
-
-    static const char* InEmoticons()
-    {
-        return "[\\x1F600-\\x1F64F]";
-    }
-
-    static const char* InOrnamental_Dingbats()
-    {
-        return "[\\x1F650-\\x1F67F]";
-    }
-
-    static const char* InTransport_and_Map_Symbols()
-    {
-        return "[\\x1F680-\\x1F6FF]";
-    }
-
-    static const char* InAlchemical_Symbols()
-    {
-        return "[\\x1F700-\\x1F77F]";
-    }
-
-    static const char* InGeometric_Shapes_Extended()
-    {
-        return "[\\x1F780-\\x1F7FF]";
-    }
-
-    static const char* InSupplemental_Arrows_C()
-    {
-        return "[\\x1F800-\\x1F8FF]";
-    }
-
-    static const char* InSupplemental_Symbols_and_Pictographs()
-    {
-        return "[\\x1F900-\\x1F9FF]";
-    }
-
-    static const char* InChess_Symbols()
-    {
-        return "[\\x1FA00-\\x1FA6F]";
-    }
-
-    static const char* InSymbols_and_Pictographs_Extended_A()
-    {
-        return "[\\x1FA70-\\x1FAFF]";
-    }
-
-    static const char* InSymbols_for_Legacy_Computing()
-    {
-        return "[\\x1FB00-\\x1FBFF]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_B()
-    {
-        return "[\\x20000-\\x2A6DF]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_C()
-    {
-        return "[\\x2A700-\\x2B73F]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_D()
-    {
-        return "[\\x2B740-\\x2B81F]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_E()
-    {
-        return "[\\x2B820-\\x2CEAF]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_F()
-    {
-        return "[\\x2CEB0-\\x2EBEF]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_I()
-    {
-        return "[\\x2EBF0-\\x2EE5F]";
-    }
-
-    static const char* InCJK_Compatibility_Ideographs_Supplement()
-    {
-        return "[\\x2F800-\\x2FA1F]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_G()
-    {
-        return "[\\x30000-\\x3134F]";
-    }
-
-    static const char* InCJK_Unified_Ideographs_Extension_H()
-    {
-        return "[\\x31350-\\x323AF]";
-    }
-
-    static const char* InTags()
-    {
-        return "[\\xE0000-\\xE007F]";
-    }
-
-    static const char* InVariation_Selectors_Supplement()
-    {
-        return "[\\xE0100-\\xE01EF]";
-    }
-
-    static const char* InSupplementary_Private_Use_Area_A()
-    {
-        return "[\\xF0000-\\xFFFFF]";
-    }
-
-    static const char* InSupplementary_Private_Use_Area_B()
-    {
-        return "[\\x100000-\\x10FFFF]";
-    }
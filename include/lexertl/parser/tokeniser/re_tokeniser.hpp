@@ -445,16 +445,10 @@ namespace lexertl
             static void escape(state& state_, string_token& token_)
             {
                 char_type ch_ = 0;
-                std::size_t str_len_ = 0;
-                const char* str_ = tokeniser_helper::escape_sequence(state_,
-                    ch_, str_len_);
 
-                if (str_)
+                if (tokeniser_helper::escape_sequence(state_, ch_, token_))
                 {
-                    char_state state2_(str_ + 1, str_ + str_len_, state_._id,
-                        state_._flags, state_._locale, nullptr);
-
-                    tokeniser_helper::charset(state2_, token_);
+                    token_.normalise();
                 }
                 else
                 {
@@ -467,21 +461,16 @@ namespace lexertl
             {
                 range range_(ch_, ch_);
 
-                token_.insert(range_);
+                token_.append(range_);
 
                 if (state_._flags & *regex_flags::icase)
                 {
-                    string_token folded_;
-
                     tokeniser_helper::fold(range_, state_._locale,
-                        folded_, typename tokeniser_helper::template
+                        token_, typename tokeniser_helper::template
                         size<sizeof(char_type)>());
-
-                    if (!folded_.empty())
-                    {
-                        token_.insert(folded_);
-                    }
                 }
+
+                token_.normalise();
             }
 
             static void open_curly(re_token& lhs_, state& state_,
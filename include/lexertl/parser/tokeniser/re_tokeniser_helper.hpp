@@ -13,23 +13,102 @@
 #include "../../runtime_error.hpp"
 #include "../../string_token.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 // strlen()
 #include <cstring>
 #include <ios>
+#include <iterator>
 #include <locale>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace lexertl
 {
     namespace detail
     {
-        struct block
+        struct unicode_range
+        {
+            uint32_t first;
+            uint32_t second;
+        };
+
+        struct unicode_property
         {
             const char* _name;
-            const char* (*_func)();
+            // The property is unicode_ranges()[_first, _last)
+            std::size_t _first;
+            std::size_t _last;
         };
 
+        // Sorted, disjoint code point ranges of every Unicode category,
+        // block (In...) and script (Is...).
+        inline const unicode_range* unicode_ranges()
+        {
+            static constexpr unicode_range ranges_[] =
+            {
+#include "ranges.inc"
+            };
+
+            return ranges_;
+        }
+
+        // Returns the property called [first_, last_), or nullptr if
+        // there is no such property.
+        template<typename iter_type>
+        const unicode_property* find_unicode_property(const iter_type first_,
+            const iter_type last_)
+        {
+            using char_type = typename std::remove_cv<typename
+                std::iterator_traits<iter_type>::value_type>::type;
+            using uchar_type = typename std::make_unsigned<char_type>::type;
+            // Sorted by name for the binary search below
+            static constexpr unicode_property properties_[] =
+            {
+#include "table.inc"
+            };
+            const unicode_property* end_ = properties_ +
+                sizeof(properties_) / sizeof(properties_[0]);
+            const unicode_property* iter_ = std::lower_bound(properties_,
+                end_, 0, [first_, last_](const unicode_property& lhs_, int)
+                {
+                    auto source_ = first_;
+                    auto name_ = lhs_._name;
+
+                    for (; source_ != last_ && *name_; ++source_, ++name_)
+                    {
+                        const auto l_ = static_cast<uchar_type>
+                            (static_cast<unsigned char>(*name_));
+                        const auto r_ = static_cast<uchar_type>(*source_);
+
+                        if (l_ != r_) return l_ < r_;
+                    }
+
+                    return !*name_ && source_ != last_;
+                });
+
+            if (iter_ != end_)
+            {
+                auto source_ = first_;
+                auto name_ = iter_->_name;
+
+                for (; source_ != last_ && *name_; ++source_, ++name_)
+                {
+                    if (static_cast<uchar_type>(*source_) !=
+                        static_cast<uchar_type>
+                            (static_cast<unsigned char>(*name_)))
+                        break;
+                }
+
+                if (source_ == last_ && !*name_)
+                    return iter_;
+            }
+
+            return nullptr;
+        }
+
         template<typename rules_char_type, typename input_char_type,
             typename id_type,
             typename char_traits = basic_char_traits<input_char_type> >
@@ -51,9 +130,11 @@ namespace lexertl
             using two = size<2>;
             using four = size<4>;
 
+            // Returns true if the escape is a charset, in which case its
+            // ranges are appended to token_, otherwise sets ch_.
             template<typename state_type, typename char_type>
-            static const char* escape_sequence(state_type& state_,
-                char_type& ch_, std::size_t& str_len_)
+            static bool escape_sequence(state_type& state_, char_type& ch_,
+                string_token& token_)
             {
                 if (state_.eos())
                 {
@@ -66,18 +147,36 @@ namespace lexertl
                     throw runtime_error(ss_.str());
                 }
 
-                const char* str_ = charset_shortcut(state_, str_len_);
+                std::size_t str_len_ = 0;
+                const char* str_ = nullptr;
 
-                if (str_)
+                if (*state_._curr == 'p')
                 {
-                    state_.increment();
+                    unicode_escape(state_, token_);
                 }
                 else
                 {
-                    ch_ = chr(state_);
+                    str_ = charset_shortcut(state_, str_len_);
+
+                    if (str_)
+                    {
+                        char_state temp_state_(str_ + 1, str_ + str_len_,
+                            state_._id, state_._flags, state_._locale,
+                            nullptr);
+                        string_token temp_token_;
+
+                        charset(temp_state_, temp_token_);
+                        token_.append(temp_token_);
+                    }
+                    else
+                    {
+                        ch_ = chr(state_);
+                        return false;
+                    }
                 }
 
-                return str_;
+                state_.increment();
+                return true;
             }
 
             // This function can call itself.
@@ -124,22 +223,7 @@ namespace lexertl
                 {
                     if (ch_ == '\\')
                     {
-                        std::size_t str_len_ = 0;
-                        const char* str_ = escape_sequence(state_, prev_,
-                            str_len_);
-
-                        chset_ = str_ != nullptr;
-
-                        if (chset_)
-                        {
-                            char_state temp_state_(str_ + 1, str_ + str_len_,
-                                state_._id, state_._flags, state_._locale,
-                                nullptr);
-                            string_token temp_token_;
-
-                            charset(temp_state_, temp_token_);
-                            token_.insert(temp_token_);
-                        }
+                        chset_ = escape_sequence(state_, prev_, token_);
                     }
                     else if (ch_ == '[' && !state_.eos() &&
                         *state_._curr == ':')
@@ -177,23 +261,19 @@ namespace lexertl
                     {
                         range range_(prev_, prev_);
 
-                        token_.insert(range_);
+                        token_.append(range_);
 
                         if (state_._flags & *regex_flags::icase)
                         {
-                            string_token folded_;
-
-                            fold(range_, state_._locale, folded_,
+                            fold(range_, state_._locale, token_,
                                 size<sizeof(input_char_type)>());
-
-                            if (!folded_.empty())
-                            {
-                                token_.insert(folded_);
-                            }
                         }
                     }
                 } while (ch_ != ']');
 
+                // Everything above appends, so sort and merge just once.
+                token_.normalise();
+
                 if (negated_)
                 {
                     token_.negate();
@@ -210,9 +290,12 @@ namespace lexertl
                 }
             }
 
+            // The fold() overloads append the other case of range_ to out_
+            // without normalising it; the caller calls out_.normalise().
             static void fold(const range& range_, const std::locale& locale_,
                 string_token& out_, const one&)
             {
+                const folded_chars& folded_ = fold_cache(locale_);
                 // If string_token::char_type is 16 bit may overflow,
                 // so use std::size_t.
                 std::size_t start_ = range_.first;
@@ -222,19 +305,17 @@ namespace lexertl
                 // therefore consider every char individually.
                 for (; start_ <= end_; ++start_)
                 {
-                    const input_char_type upper_ = std::toupper
-                    (static_cast<input_char_type>(start_), locale_);
-                    const input_char_type lower_ = std::tolower
-                    (static_cast<input_char_type>(start_), locale_);
+                    const index_type upper_ = folded_._upper[start_];
+                    const index_type lower_ = folded_._lower[start_];
 
-                    if (upper_ != static_cast<input_char_type>(start_))
+                    if (upper_ != start_)
                     {
-                        out_.insert(range(upper_, upper_));
+                        out_.append(range(upper_, upper_));
                     }
 
-                    if (lower_ != static_cast<input_char_type>(start_))
+                    if (lower_ != start_)
                     {
-                        out_.insert(range(lower_, lower_));
+                        out_.append(range(lower_, lower_));
                     }
                 }
             }
@@ -245,11 +326,12 @@ namespace lexertl
                 static const fold_pair mapping_[] =
                 {
 #include "fold2.inc"
-                    {{0, 0}, {0, 0}}
                 };
-                const fold_pair* ptr_ = mapping_;
+                const fold_pair* end_ = mapping_ +
+                    sizeof(mapping_) / sizeof(mapping_[0]);
+                const fold_pair* ptr_ = first_fold(mapping_, end_, range_);
 
-                for (; ptr_->from.first != 0; ++ptr_)
+                for (; ptr_ != end_; ++ptr_)
                 {
                     if (range_.second < ptr_->from.first) break;
 
@@ -261,7 +343,7 @@ namespace lexertl
                             const index_type first_ = ptr_->to.first +
                                 (range_.first - ptr_->from.first);
 
-                            out_.insert(range(first_,
+                            out_.append(range(first_,
                                 range_.second > ptr_->from.second ?
                                 ptr_->to.second :
                                 static_cast<index_type>(ptr_->to.first +
@@ -272,7 +354,7 @@ namespace lexertl
                             const index_type first_ = ptr_->to.second +
                                 (range_.first - ptr_->from.first);
 
-                            out_.insert(range(first_,
+                            out_.append(range(first_,
                                 range_.second > ptr_->from.second ?
                                 ptr_->to.first :
                                 static_cast<index_type>(ptr_->to.second +
@@ -287,14 +369,14 @@ namespace lexertl
                             const index_type second_ = ptr_->to.first +
                                 (range_.second - ptr_->from.first);
 
-                            out_.insert(range(ptr_->to.first, second_));
+                            out_.append(range(ptr_->to.first, second_));
                         }
                         else
                         {
                             const index_type second_ = ptr_->to.second +
                                 (range_.second - ptr_->from.first);
 
-                            out_.insert(range(ptr_->to.second, second_));
+                            out_.append(range(ptr_->to.second, second_));
                         }
                     }
                     // Either range fully encompasses from range or not at all.
@@ -303,11 +385,11 @@ namespace lexertl
                     {
                         if (ptr_->to.first <= ptr_->to.second)
                         {
-                            out_.insert(range(ptr_->to.first, ptr_->to.second));
+                            out_.append(range(ptr_->to.first, ptr_->to.second));
                         }
                         else
                         {
-                            out_.insert(range(ptr_->to.second, ptr_->to.first));
+                            out_.append(range(ptr_->to.second, ptr_->to.first));
                         }
                     }
                 }
@@ -324,18 +406,19 @@ namespace lexertl
                 static const fold_pair mapping_[] =
                 {
 #include "fold4.inc"
-                    {{0, 0}, {0, 0}}
                 };
-                const fold_pair* ptr_ = mapping_;
+                const fold_pair* end_ = mapping_ +
+                    sizeof(mapping_) / sizeof(mapping_[0]);
+                const fold_pair* ptr_ = first_fold(mapping_, end_, range_);
 
-                for (; ptr_->from.first != 0; ++ptr_)
+                for (; ptr_ != end_; ++ptr_)
                 {
                     if (range_.second < ptr_->from.first) break;
 
                     if (range_.first >= ptr_->from.first &&
                         range_.first <= ptr_->from.second)
                     {
-                        out_.insert(range(ptr_->to.first +
+                        out_.append(range(ptr_->to.first +
                             (range_.first - ptr_->from.first),
                             range_.second > ptr_->from.second ?
                             ptr_->to.second :
@@ -345,7 +428,7 @@ namespace lexertl
                     else if (range_.second >= ptr_->from.first &&
                         range_.second <= ptr_->from.second)
                     {
-                        out_.insert(range(ptr_->to.first,
+                        out_.append(range(ptr_->to.first,
                             ptr_->to.first + (range_.second -
                                 ptr_->from.first)));
                     }
@@ -353,7 +436,7 @@ namespace lexertl
                     else if (ptr_->from.first >= range_.first &&
                         ptr_->from.first <= range_.second)
                     {
-                        out_.insert(range(ptr_->to.first, ptr_->to.second));
+                        out_.append(range(ptr_->to.first, ptr_->to.second));
                     }
                 }
             }
@@ -436,6 +519,57 @@ namespace lexertl
                 char_pair to;
             };
 
+            // toupper() and tolower() of every 8 bit char for one locale
+            struct folded_chars
+            {
+                // Keeps _ctype alive
+                std::locale _locale;
+                const std::ctype<input_char_type>* _ctype = nullptr;
+                std::array<index_type, 256> _upper;
+                std::array<index_type, 256> _lower;
+            };
+
+            // The mapping_ entries are sorted and do not overlap, so skip
+            // straight to the first one that can intersect range_.
+            static const fold_pair* first_fold(const fold_pair* mapping_,
+                const fold_pair* end_, const range& range_)
+            {
+                return std::lower_bound(mapping_, end_, range_.first,
+                    [](const fold_pair& lhs_, const index_type rhs_)
+                    {
+                        return static_cast<index_type>(lhs_.from.second) <
+                            rhs_;
+                    });
+            }
+
+            // Caches the folded chars of the last locale used by each
+            // thread, as calling std::toupper() and std::tolower() for
+            // every char of every range is slow.
+            static const folded_chars& fold_cache(const std::locale& locale_)
+            {
+                static thread_local folded_chars folded_;
+                const std::ctype<input_char_type>* ctype_ =
+                    &std::use_facet<std::ctype<input_char_type>>(locale_);
+
+                if (folded_._ctype != ctype_)
+                {
+                    folded_._locale = locale_;
+                    folded_._ctype = ctype_;
+
+                    for (std::size_t i_ = 0; i_ < folded_._upper.size(); ++i_)
+                    {
+                        const auto ch_ = static_cast<input_char_type>(i_);
+
+                        folded_._upper[i_] =
+                            static_cast<index_type>(ctype_->toupper(ch_));
+                        folded_._lower[i_] =
+                            static_cast<index_type>(ctype_->tolower(ch_));
+                    }
+                }
+
+                return folded_;
+            }
+
             template<typename state_type>
             static void posix(state_type& state_, string_token& token_)
             {
@@ -1053,7 +1187,8 @@ namespace lexertl
 
                 if (negate_) temp_token_.negate();
 
-                token_.insert(temp_token_);
+                // charset() normalises token_ once it is complete
+                token_.append(temp_token_);
             }
 
             template<typename state_type>
@@ -1070,9 +1205,6 @@ namespace lexertl
                 case 'D':
                     str_ = "[^0-9]";
                     break;
-                case 'p':
-                    str_ = unicode_escape(state_);
-                    break;
                 case 's':
                     str_ = "[ \t\n\r\f\v]";
                     break;
@@ -1104,11 +1236,12 @@ namespace lexertl
                 return str_;
             }
 
+            // Appends the ranges of \p{name} to token_, leaving
+            // state_ on the closing '}'.
             template<typename state_type>
-            static const char* unicode_escape(state_type& state_)
+            static void unicode_escape(state_type& state_,
+                string_token& token_)
             {
-                const char* str_ = nullptr;
-
                 state_.increment();
 
                 if (state_.eos())
@@ -1164,44 +1297,54 @@ namespace lexertl
                     throw runtime_error(ss_.str());
                 }
 
-                static const block lookup_[] =
+                const unicode_property* property_ =
+                    find_unicode_property(start_, state_._curr);
+
+                if (property_ == nullptr)
                 {
-#include "table.inc"
-                };
+                    std::ostringstream ss_;
 
-                for (const block* entry_ = lookup_; entry_->_name; ++entry_)
+                    ss_ << "Syntax error following \\p{ at index " << idx_;
+                    state_.error(ss_);
+                    throw runtime_error(ss_.str());
+                }
+
+                const unicode_range* ranges_ = unicode_ranges();
+
+                for (std::size_t i_ = property_->_first;
+                    i_ != property_->_last; ++i_)
                 {
-                    auto source_ = start_;
-                    auto name_ = entry_->_name;
+                    const unicode_range& unicode_range_ = ranges_[i_];
 
-                    for (; source_ != state_._curr && *name_;
-                        ++source_, ++name_)
+                    if (unicode_range_.second >
+                        static_cast<std::size_t>(char_traits::max_val()))
                     {
-                        if (*source_ !=
-                            static_cast<typename state_type::char_type>(*name_))
-                            break;
+                        std::ostringstream ss_;
+
+                        ss_ << "Escape \\x" << std::hex <<
+                            (unicode_range_.first >
+                            static_cast<std::size_t>(char_traits::max_val()) ?
+                            unicode_range_.first : unicode_range_.second) <<
+                            " is too big for the state machine char type " <<
+                            "preceding index " << std::dec << state_.index();
+                        state_.error(ss_);
+                        throw runtime_error(ss_.str());
                     }
 
-                    if (source_ == state_._curr && !*name_)
-                        return str_ = entry_->_func();
-                }
+                    const range range_(static_cast<index_type>
+                        (unicode_range_.first),
+                        static_cast<index_type>(unicode_range_.second));
 
-                if (str_ == nullptr)
-                {
-                    std::ostringstream ss_;
+                    token_.append(range_);
 
-                    ss_ << "Syntax error following \\p{ at index " << idx_;
-                    state_.error(ss_);
-                    throw runtime_error(ss_.str());
+                    if (state_._flags & *regex_flags::icase)
+                    {
+                        fold(range_, state_._locale, token_,
+                            size<sizeof(input_char_type)>());
+                    }
                 }
-
-                return str_;
             }
 
-#include "blocks.hpp"
-#include "scripts.hpp"
-#include "unicode.hpp"
-
             template<typename state_type>
             static input_char_type decode_octal(state_type& state_)
             {
@@ -1409,9 +1552,9 @@ namespace lexertl
 
                 if (ch_ == '\\')
                 {
-                    std::size_t str_len_ = 0;
+                    string_token temp_token_;
 
-                    if (escape_sequence(state_, curr_, str_len_))
+                    if (escape_sequence(state_, curr_, temp_token_))
                     {
                         std::ostringstream ss_;
 
@@ -1473,20 +1616,14 @@ namespace lexertl
                 if (state_._flags & *regex_flags::icase)
                 {
                     range range_(start_, end_);
-                    string_token folded_;
 
-                    chars_.insert(range_);
-                    fold(range_, state_._locale, folded_,
+                    chars_.append(range_);
+                    fold(range_, state_._locale, chars_,
                         size<sizeof(input_char_type)>());
-
-                    if (!folded_.empty())
-                    {
-                        chars_.insert(folded_);
-                    }
                 }
                 else
                 {
-                    chars_.insert(range(prev_, curr_));
+                    chars_.append(range(prev_, curr_));
                 }
             }
         };
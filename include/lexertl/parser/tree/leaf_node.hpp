@@ -92,9 +92,8 @@ namespace lexertl
                 node_stack& new_node_stack_, bool_stack&/*perform_op_stack_*/,
                 bool&/*down_*/) const override
             {
-                node_ptr_vector_.push_back(std::make_unique<basic_leaf_node>
-                    (_token, _greedy));
-                new_node_stack_.push(node_ptr_vector_.back().get());
+                new_node_stack_.push(node_ptr_vector_.template create
+                    <basic_leaf_node>(_token, _greedy));
             }
         };
     }
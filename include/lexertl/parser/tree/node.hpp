@@ -6,12 +6,13 @@
 #ifndef LEXERTL_NODE_HPP
 #define LEXERTL_NODE_HPP
 
+#include "../../arena.hpp"
 #include "../../enums.hpp"
 #include "../../observer_ptr.hpp"
 #include "../../runtime_error.hpp"
 
 #include <cassert>
-#include <memory>
+#include <cstddef>
 #include <stack>
 #include <vector>
 
@@ -29,7 +30,8 @@ namespace lexertl
             using node_stack = std::stack<observer_ptr<basic_node>>;
             using const_node_stack = std::stack<observer_ptr<const basic_node>>;
             using node_vector = std::vector<observer_ptr<basic_node>>;
-            using node_ptr_vector = std::vector<std::unique_ptr<basic_node>>;
+            // Owns every node created while building a state machine
+            using node_ptr_vector = arena_ptr_vector<basic_node>;
 
             basic_node() = default;
 
@@ -126,6 +128,19 @@ namespace lexertl
                 return _lastpos;
             }
 
+            // Leaf and end nodes are numbered densely (from 0 within each
+            // lexer state) once the syntax tree is complete, so that sets
+            // of them can be held as sorted vectors of positions.
+            std::size_t position() const
+            {
+                return _position;
+            }
+
+            void position(const std::size_t position_)
+            {
+                _position = position_;
+            }
+
             virtual bool end_state() const
             {
                 return false;
@@ -235,6 +250,7 @@ namespace lexertl
             const bool _nullable = false;
             node_vector _firstpos;
             node_vector _lastpos;
+            std::size_t _position = 0;
         };
     }
 }
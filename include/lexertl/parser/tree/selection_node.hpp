@@ -80,9 +80,8 @@ namespace lexertl
 
                     observer_ptr<node> lhs_ = new_node_stack_.top();
 
-                    node_ptr_vector_.push_back(std::make_unique
-                        <basic_selection_node>(lhs_, rhs_));
-                    new_node_stack_.top() = node_ptr_vector_.back().get();
+                    new_node_stack_.top() = node_ptr_vector_.template create
+                        <basic_selection_node>(lhs_, rhs_);
                 }
                 else
                 {
@@ -98,9 +98,8 @@ namespace lexertl
 
                     observer_ptr<node> lhs_ = new_node_stack_.top();
 
-                    node_ptr_vector_.push_back(std::make_unique
-                        <basic_sequence_node>(lhs_, rhs_));
-                    new_node_stack_.top() = node_ptr_vector_.back().get();
+                    new_node_stack_.top() = node_ptr_vector_.template create
+                        <basic_sequence_node>(lhs_, rhs_);
                 }
                 else
                 {
@@ -11,6 +11,7 @@
 #include "../observer_ptr.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <set>
 #include <vector>
@@ -48,7 +49,10 @@ namespace lexertl
                 return _index_vector.empty() && _followpos.empty();
             }
 
-            void intersect(basic_equivset& rhs_, basic_equivset& overlap_)
+            // marked_ is indexed by node position and must be all false.
+            // It is left that way.
+            void intersect(basic_equivset& rhs_, basic_equivset& overlap_,
+                std::vector<bool>& marked_)
             {
                 intersect_indexes(rhs_._index_vector, overlap_._index_vector);
 
@@ -59,20 +63,8 @@ namespace lexertl
                     overlap_._id = _id;
                     process_greedy(rhs_, overlap_);
                     overlap_._followpos = _followpos;
-
-                    auto overlap_begin_ = overlap_._followpos.cbegin();
-                    auto overlap_end_ = overlap_._followpos.cend();
-
-                    for (observer_ptr<node> node_ : rhs_._followpos)
-                    {
-                        if (std::find(overlap_begin_, overlap_end_, node_) ==
-                            overlap_end_)
-                        {
-                            overlap_._followpos.push_back(node_);
-                            overlap_begin_ = overlap_._followpos.begin();
-                            overlap_end_ = overlap_._followpos.end();
-                        }
-                    }
+                    merge_followpos(rhs_._followpos, overlap_._followpos,
+                        marked_);
 
                     if (_index_vector.empty())
                     {
@@ -87,6 +79,50 @@ namespace lexertl
             }
 
         private:
+            // Appends the nodes of rhs_ not already in overlap_, in order.
+            // rhs_ is usually only a handful of nodes, in which case a
+            // linear search of overlap_ is quickest. Otherwise overlap_ is
+            // marked by node position so that the cost is linear rather
+            // than quadratic.
+            static void merge_followpos(const node_vector& rhs_,
+                node_vector& overlap_, std::vector<bool>& marked_)
+            {
+                if (rhs_.size() <= 8)
+                {
+                    for (observer_ptr<node> node_ : rhs_)
+                    {
+                        if (std::find(overlap_.cbegin(), overlap_.cend(),
+                            node_) == overlap_.cend())
+                        {
+                            overlap_.push_back(node_);
+                        }
+                    }
+
+                    return;
+                }
+
+                for (observer_ptr<const node> node_ : overlap_)
+                {
+                    marked_[node_->position()] = true;
+                }
+
+                for (observer_ptr<node> node_ : rhs_)
+                {
+                    const std::size_t position_ = node_->position();
+
+                    if (!marked_[position_])
+                    {
+                        marked_[position_] = true;
+                        overlap_.push_back(node_);
+                    }
+                }
+
+                for (observer_ptr<const node> node_ : overlap_)
+                {
+                    marked_[node_->position()] = false;
+                }
+            }
+
             void process_greedy(basic_equivset& rhs_,
                 basic_equivset& overlap_) const
             {
@@ -0,0 +1,128 @@
+// profile.hpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef LEXERTL_PROFILE_HPP
+#define LEXERTL_PROFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace lexertl
+{
+    // How often each lexer state, DFA state and rule was used, as
+    // recorded by lookup() for match_results with feature_bit::profile
+    // set. Point match_results::profile at one of these, feed real input
+    // through lookup() and pass the result to
+    // basic_state_machine::renumber() and basic_flat_state_machine to lay
+    // the tables out accordingly, or basic_debug::dump() it to see which
+    // rules are hot. States are numbered as in the basic_state_machine the
+    // tables came from (the row index).
+    template<typename id_ty = uint16_t>
+    struct basic_profile
+    {
+        using id_type = id_ty;
+        using count_vector = std::vector<std::size_t>;
+        using id_count_map = std::map<id_type, std::size_t>;
+
+        // Number of DFA walks started in each lexer state
+        count_vector _dfas;
+        // Number of times each state of each lexer state was entered on
+        // a transition (runs skipped by accel_state are not counted, so
+        // lookup() does not accelerate when profiling).
+        std::vector<count_vector> _states;
+        // Number of matches of each rule id (including skipped tokens)
+        id_count_map _rules;
+        // Characters read by the DFA walks, including those read beyond
+        // the end of the longest match.
+        std::size_t _examined = 0;
+        // Characters in the tokens found, or skipped as unmatched.
+        std::size_t _consumed = 0;
+
+        void clear()
+        {
+            _dfas.clear();
+            _states.clear();
+            _rules.clear();
+            _examined = 0;
+            _consumed = 0;
+        }
+
+        bool empty() const
+        {
+            return _dfas.empty();
+        }
+
+        void start(const id_type dfa_)
+        {
+            if (dfa_ >= _dfas.size())
+            {
+                _dfas.resize(static_cast<std::size_t>(dfa_) + 1, 0);
+                _states.resize(_dfas.size());
+            }
+
+            ++_dfas[dfa_];
+        }
+
+        // dfa_ must have been start()ed
+        void visit(const id_type dfa_, const std::size_t state_)
+        {
+            count_vector& states_ = _states[dfa_];
+
+            if (state_ >= states_.size())
+            {
+                states_.resize(state_ + 1, 0);
+            }
+
+            ++states_[state_];
+        }
+
+        void match(const id_type id_)
+        {
+            ++_rules[id_];
+        }
+
+        std::size_t starts(const std::size_t dfa_) const
+        {
+            return dfa_ < _dfas.size() ? _dfas[dfa_] : 0;
+        }
+
+        std::size_t visits(const std::size_t dfa_,
+            const std::size_t state_) const
+        {
+            return dfa_ < _states.size() && state_ < _states[dfa_].size() ?
+                _states[dfa_][state_] : 0;
+        }
+
+        void swap(basic_profile& rhs_) noexcept
+        {
+            _dfas.swap(rhs_._dfas);
+            _states.swap(rhs_._states);
+            _rules.swap(rhs_._rules);
+            std::swap(_examined, rhs_._examined);
+            std::swap(_consumed, rhs_._consumed);
+        }
+    };
+
+    namespace detail
+    {
+        template<typename id_type, bool>
+        struct match_profile
+        {
+        };
+
+        template<typename id_type>
+        struct match_profile<id_type, true>
+        {
+            basic_profile<id_type>* profile = nullptr;
+        };
+    }
+
+    using profile = basic_profile<>;
+}
+
+#endif
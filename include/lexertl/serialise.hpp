@@ -6,10 +6,13 @@
 #ifndef LEXERTL_SERIALISE_HPP
 #define LEXERTL_SERIALISE_HPP
 
+#include "flat_state_machine.hpp"
 #include "internals.hpp"
+#include "profile.hpp"
 #include "runtime_error.hpp"
 #include "state_machine.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -18,8 +21,10 @@ namespace lexertl
 {
     namespace detail
     {
-        template<typename char_type, typename id_type, class stream>
-        void output_vec(const std::vector<id_type>& vec_, stream& stream_)
+        template<typename char_type, typename id_type, typename alloc,
+            class stream>
+        void output_vec(const std::vector<id_type, alloc>& vec_,
+            stream& stream_)
         {
             std::basic_ostringstream<char_type> ss_;
             std::basic_string<char_type> str_;
@@ -49,8 +54,9 @@ namespace lexertl
             stream_ << '\n';
         }
 
-        template<typename char_type, class stream, typename id_type>
-        void input_vec(stream& stream_, std::vector<id_type>& vec_)
+        template<typename char_type, class stream, typename id_type,
+            typename alloc>
+        void input_vec(stream& stream_, std::vector<id_type, alloc>& vec_)
         {
             std::size_t num_ = 0;
 
@@ -139,6 +145,202 @@ namespace lexertl
             detail::input_vec<char_type>(stream_, internals_._dfa.back());
         }
     }
+
+    template<typename char_type, typename id_type, class stream>
+    void save(const basic_flat_state_machine<char_type, id_type>& sm_,
+        stream& stream_)
+    {
+        using internals = detail::basic_flat_internals<id_type>;
+        const internals& internals_ = sm_.data();
+
+        // Version number
+        stream_ << 2 << '\n';
+        stream_ << sizeof(char_type) << '\n';
+        stream_ << sizeof(id_type) << '\n';
+        stream_ << internals_._eoi << '\n';
+        stream_ << internals_._features << '\n';
+        stream_ << internals_._entry_size << '\n';
+        stream_ << internals_._row_offsets << '\n';
+        stream_ << internals_._paged << '\n';
+        detail::output_vec<char_type>(internals_._lookup, stream_);
+        detail::output_vec<char_type>(internals_._dfa, stream_);
+        detail::output_vec<char_type>(internals_._dfa_size, stream_);
+
+        // The arena is saved as is (padding included), so that load()
+        // does not need to lay it out again.
+        std::vector<id_type> arena_(internals_.size());
+
+        for (std::size_t idx_ = 0, size_ = arena_.size(); idx_ < size_;
+            ++idx_)
+        {
+            arena_[idx_] = internals_.at(idx_);
+        }
+
+        detail::output_vec<char_type>(arena_, stream_);
+        detail::output_vec<char_type>(internals_._accel_bit, stream_);
+        detail::output_vec<char_type>(internals_._accel_row, stream_);
+
+        // Bytes are saved as numbers, not characters.
+        std::vector<std::size_t> bytes_(internals_._accel_bits.cbegin(),
+            internals_._accel_bits.cend());
+
+        detail::output_vec<char_type>(bytes_, stream_);
+        bytes_.clear();
+
+        // Each accel_state as its size followed by its exit bytes
+        for (const auto& accel_ : internals_._accel)
+        {
+            bytes_.push_back(accel_._size);
+
+            if (!accel_.empty())
+            {
+                bytes_.insert(bytes_.end(), accel_._exit,
+                    accel_._exit + accel_._size);
+            }
+        }
+
+        detail::output_vec<char_type>(bytes_, stream_);
+    }
+
+    template<typename char_type, typename id_type, class stream>
+    void load(stream& stream_,
+        basic_flat_state_machine<char_type, id_type>& sm_)
+    {
+        using internals = detail::basic_flat_internals<id_type>;
+        internals& internals_ = sm_.data();
+        std::size_t num_ = 0;
+
+        internals_.clear();
+        // Version
+        stream_ >> num_;
+        // sizeof(char_type)
+        stream_ >> num_;
+
+        if (num_ != sizeof(char_type))
+            throw runtime_error("char_type mismatch in lexertl::load().");
+
+        // sizeof(id_type)
+        stream_ >> num_;
+
+        if (num_ != sizeof(id_type))
+            throw runtime_error("id_type mismatch in lexertl::load().");
+
+        stream_ >> internals_._eoi;
+        stream_ >> internals_._features;
+        stream_ >> internals_._entry_size;
+        stream_ >> internals_._row_offsets;
+        stream_ >> internals_._paged;
+        detail::input_vec<char_type>(stream_, internals_._lookup);
+        detail::input_vec<char_type>(stream_, internals_._dfa);
+        detail::input_vec<char_type>(stream_, internals_._dfa_size);
+
+        std::vector<id_type> arena_;
+
+        detail::input_vec<char_type>(stream_, arena_);
+        internals_._arena.resize(arena_.size() * internals_._entry_size);
+
+        for (std::size_t idx_ = 0, size_ = arena_.size(); idx_ < size_;
+            ++idx_)
+        {
+            internals_.set(idx_, arena_[idx_]);
+        }
+
+        detail::input_vec<char_type>(stream_, internals_._accel_bit);
+        detail::input_vec<char_type>(stream_, internals_._accel_row);
+
+        detail::input_vec<char_type>(stream_, internals_._accel_bits);
+
+        std::vector<std::size_t> bytes_;
+
+        detail::input_vec<char_type>(stream_, bytes_);
+
+        for (auto iter_ = bytes_.cbegin(), end_ = bytes_.cend();
+            iter_ != end_;)
+        {
+            detail::accel_state accel_;
+
+            accel_._size = static_cast<unsigned char>(*iter_++);
+
+            if (!accel_.empty())
+            {
+                if (accel_._size > detail::accel_state::max_exit ||
+                    static_cast<std::size_t>(end_ - iter_) < accel_._size)
+                {
+                    throw runtime_error("Invalid accel_state in "
+                        "lexertl::load().");
+                }
+
+                std::copy(iter_, iter_ + accel_._size, accel_._exit);
+                iter_ += accel_._size;
+            }
+
+            internals_._accel.push_back(accel_);
+        }
+    }
+
+    // Save a profile to load back alongside the machine it was recorded
+    // with.
+    template<typename id_type, class stream>
+    void save(const basic_profile<id_type>& profile_, stream& stream_)
+    {
+        using char_type = typename stream::char_type;
+        std::vector<id_type> ids_;
+        std::vector<std::size_t> counts_;
+
+        // Version number
+        stream_ << 1 << '\n';
+        stream_ << profile_._examined << '\n';
+        stream_ << profile_._consumed << '\n';
+        detail::output_vec<char_type>(profile_._dfas, stream_);
+
+        for (const auto& vec_ : profile_._states)
+        {
+            detail::output_vec<char_type>(vec_, stream_);
+        }
+
+        for (const auto& pair_ : profile_._rules)
+        {
+            ids_.push_back(pair_.first);
+            counts_.push_back(pair_.second);
+        }
+
+        detail::output_vec<char_type>(ids_, stream_);
+        detail::output_vec<char_type>(counts_, stream_);
+    }
+
+    template<typename id_type, class stream>
+    void load(stream& stream_, basic_profile<id_type>& profile_)
+    {
+        using char_type = typename stream::char_type;
+        std::size_t num_ = 0;
+
+        std::vector<id_type> ids_;
+        std::vector<std::size_t> counts_;
+
+        profile_.clear();
+        // Version
+        stream_ >> num_;
+        stream_ >> profile_._examined;
+        stream_ >> profile_._consumed;
+        detail::input_vec<char_type>(stream_, profile_._dfas);
+        profile_._states.resize(profile_._dfas.size());
+
+        for (auto& vec_ : profile_._states)
+        {
+            detail::input_vec<char_type>(stream_, vec_);
+        }
+
+        detail::input_vec<char_type>(stream_, ids_);
+        detail::input_vec<char_type>(stream_, counts_);
+
+        if (ids_.size() != counts_.size())
+            throw runtime_error("Rule counts mismatch in lexertl::load().");
+
+        for (std::size_t idx_ = 0, size_ = ids_.size(); idx_ < size_; ++idx_)
+        {
+            profile_._rules[ids_[idx_]] = counts_[idx_];
+        }
+    }
 }
 
 #endif
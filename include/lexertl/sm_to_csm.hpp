@@ -8,8 +8,10 @@
 
 #include "enum_operator.hpp"
 #include "enums.hpp"
+#include "internals.hpp"
 #include "observer_ptr.hpp"
 
+#include <algorithm>
 #include <cstddef>
 
 namespace lexertl
@@ -33,18 +35,44 @@ namespace lexertl
             const std::size_t alphabet_ = internals_._dfa_alphabet[i_] -
                 *state_index::transitions;
             string_token_vector token_vector_(alphabet_, string_token());
-            observer_ptr<const id_type> ptr_ = &internals_._lookup[i_].front();
+            const auto& lookup_ = internals_._lookup[i_];
+            observer_ptr<const id_type> ptr_ = &lookup_.front();
+            const std::size_t max_ = internals_.paged() ?
+                std::min(static_cast<std::size_t>
+                (string_token::char_traits::max_val()),
+                static_cast<std::size_t>(detail::paged_lookup::max_char)) :
+                255;
+            std::size_t first_ = 0;
+            id_type class_ = *ptr_;
 
-            for (std::size_t c_ = 0; c_ < 256; ++c_, ++ptr_)
+            // Gather runs of characters in the same class
+            for (std::size_t c_ = 1; c_ <= max_ + 1; ++c_)
             {
-                if (*ptr_ >= *state_index::transitions)
+                id_type next_ = 0;
+
+                if (c_ <= max_)
+                {
+                    const std::size_t page_ = c_ < detail::paged_lookup::page ?
+                        0 : lookup_[detail::paged_lookup::index + (c_ >> 8)];
+
+                    next_ = ptr_[page_ * detail::paged_lookup::page +
+                        (c_ & 0xff)];
+                }
+
+                if (c_ <= max_ && next_ == class_)
+                    continue;
+
+                if (class_ >= *state_index::transitions)
                 {
                     string_token& token_ = token_vector_
-                        [*ptr_ - *state_index::transitions];
+                        [class_ - *state_index::transitions];
 
                     token_.insert(typename string_token::range
-                    (index_type(c_), index_type(c_)));
+                    (index_type(first_), index_type(c_ - 1)));
                 }
+
+                first_ = c_;
+                class_ = next_;
             }
 
             csm_.append(token_vector_, internals_, i_);
@@ -9,14 +9,16 @@
 
 namespace lexertl
 {
+    // utf8 means that charsets are compiled to UTF-8 byte sequences
+    // rather than being sliced into fixed width (big endian) bytes.
     template<typename ch_type, typename sm_type, bool comp, bool look,
-        bool dfa_nfa>
+        bool dfa_nfa, bool utf = false>
     struct basic_sm_traits
     {
         enum
         {
             char_24_bit = sizeof(ch_type) > 2, compressed = comp, lookup = look,
-            is_dfa = dfa_nfa
+            is_dfa = dfa_nfa, utf8 = utf
         };
         using input_char_type = ch_type;
         using char_type = ch_type;
@@ -28,13 +30,14 @@ namespace lexertl
         }
     };
 
-    template<typename ch_type, typename sm_type, bool look, bool dfa_nfa>
-    struct basic_sm_traits<ch_type, sm_type, true, look, dfa_nfa>
+    template<typename ch_type, typename sm_type, bool look, bool dfa_nfa,
+        bool utf>
+    struct basic_sm_traits<ch_type, sm_type, true, look, dfa_nfa, utf>
     {
         enum
         {
             char_24_bit = sizeof(ch_type) > 2, compressed = true, lookup = look,
-            is_dfa = dfa_nfa
+            is_dfa = dfa_nfa, utf8 = utf
         };
         using input_char_type = ch_type;
         using char_type = unsigned char;
@@ -45,6 +48,19 @@ namespace lexertl
             return static_cast<id_type>(~0);
         }
     };
+
+    // Traits for a wide character state machine that classifies each
+    // code point with a single (paged) table lookup instead of slicing it
+    // into bytes.
+    template<typename ch_type, typename sm_type>
+    using basic_paged_sm_traits =
+        basic_sm_traits<ch_type, sm_type, false, true, true>;
+
+    // Traits for a byte state machine built from code point rules, where
+    // every charset becomes the UTF-8 sequences that encode it.
+    template<typename ch_type, typename sm_type>
+    using basic_utf8_sm_traits =
+        basic_sm_traits<ch_type, sm_type, true, true, true, true>;
 }
 
 #endif
@@ -6,17 +6,21 @@
 #ifndef LEXERTL_STATE_MACHINE_HPP
 #define LEXERTL_STATE_MACHINE_HPP
 
+#include "build_observer.hpp"
 #include "enums.hpp"
 #include "internals.hpp"
+#include "minimise.hpp"
 #include "observer_ptr.hpp"
+#include "profile.hpp"
 #include "sm_traits.hpp"
 #include "string_token.hpp"
 
-// memcmp()
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdint>
-#include <cstring>
 #include <map>
-#include <set>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -63,7 +67,10 @@ namespace lexertl
             return _internals._eoi;
         }
 
-        void minimise()
+        // observer_ (if any) is told how long each DFA took and how many
+        // states it has left.
+        void minimise(const observer_ptr<basic_build_observer<id_type>>
+            observer_ = nullptr)
         {
             const auto dfas_ = static_cast<id_type>(_internals._dfa.size());
 
@@ -71,16 +78,58 @@ namespace lexertl
             {
                 const id_type dfa_alphabet_ = _internals._dfa_alphabet[i_];
                 id_type_vector& dfa_ = _internals._dfa[i_];
+                const auto start_ = observer_ ?
+                    std::chrono::steady_clock::now() :
+                    std::chrono::steady_clock::time_point();
 
                 if (dfa_alphabet_ != 0)
                 {
-                    std::size_t size_ = 0;
+                    minimise_dfa(dfa_alphabet_, dfa_);
+                }
 
-                    do
-                    {
-                        size_ = dfa_.size();
-                        minimise_dfa(dfa_alphabet_, dfa_, size_);
-                    } while (dfa_.size() != size_);
+                if (observer_)
+                {
+                    // Less the jam state
+                    const std::size_t states_ = dfa_alphabet_ == 0 ? 0 :
+                        dfa_.size() / dfa_alphabet_ - 1;
+
+                    observer_->phase(i_, build_phase::minimise,
+                        std::chrono::steady_clock::now() - start_);
+                    observer_->states(i_, states_, states_);
+                }
+            }
+        }
+
+        // Renumber the states of each DFA so that the states most likely
+        // to follow one another are stored next to each other. States are
+        // laid out depth first from the start state (then the bol start
+        // state), always following the successor reached by the most
+        // characters first, so that the common path through each DFA
+        // occupies consecutive rows. Call after minimise().
+        void renumber()
+        {
+            renumber(basic_profile<id_type>());
+        }
+
+        // As above, but following the successor that profile_ saw entered
+        // most often. The states it never saw entered are moved after all
+        // the others (in their original order), so that the hot rows are
+        // packed together at the front of each DFA. Lexer states that
+        // profile_ has no counts for are laid out as above.
+        void renumber(const basic_profile<id_type>& profile_)
+        {
+            const auto dfas_ = static_cast<id_type>(_internals._dfa.size());
+            const std::vector<std::size_t> none_;
+
+            for (id_type i_ = 0; i_ < dfas_; ++i_)
+            {
+                const id_type dfa_alphabet_ = _internals._dfa_alphabet[i_];
+
+                if (dfa_alphabet_ != 0)
+                {
+                    renumber_dfa(dfa_alphabet_, _internals._lookup[i_],
+                        i_ < profile_._states.size() ?
+                        profile_._states[i_] : none_, _internals._dfa[i_]);
                 }
             }
         }
@@ -102,106 +151,234 @@ namespace lexertl
 
     private:
         using id_type_vector = typename internals::id_type_vector;
-        using index_set = std::set<id_type>;
         internals _internals;
 
+        // Merges equivalent states by partition refinement. Rows start off
+        // grouped by the columns before eol (end state flags, id, user id,
+        // push and next dfa), then the eol and transition columns are
+        // treated as the alphabet, with the jam state as the dead state.
         void minimise_dfa(const id_type dfa_alphabet_,
-            id_type_vector& dfa_, std::size_t size_) const
+            id_type_vector& dfa_) const
         {
-            id_type_vector lookup_(size_ / dfa_alphabet_, npos());
-
-            if (lookup_.empty())
+            using key = std::array<id_type, +state_index::eol>;
+            using refiner = detail::basic_partition_refiner<id_type>;
+            const std::size_t rows_ = dfa_.size() / dfa_alphabet_;
+            std::map<key, id_type> blocks_;
+            id_type_vector initial_;
+
+            // The jam state and at most one other
+            if (rows_ < 3)
                 return;
 
-            observer_ptr<const id_type> first_ = &dfa_.front();
-            observer_ptr<const id_type> end_ = first_ + size_;
-            id_type index_ = 1;
-            id_type new_index_ = 1;
-            observer_ptr<id_type> lookup_ptr_ = &lookup_.front();
-            index_set index_set_;
-            const id_type bol_index_ = dfa_.front();
+            initial_.reserve(rows_ - 1);
+
+            for (std::size_t row_ = 1; row_ < rows_; ++row_)
+            {
+                observer_ptr<const id_type> ptr_ =
+                    &dfa_[row_ * dfa_alphabet_];
+                key key_;
+
+                std::copy(ptr_, ptr_ + key_.size(), key_.begin());
+                initial_.push_back(blocks_.emplace(key_,
+                    static_cast<id_type>(blocks_.size())).first->second);
+            }
 
-            *lookup_ptr_ = 0;
-            // Only one 'jam' state, so skip it.
-            first_ += dfa_alphabet_;
+            refiner refiner_(initial_);
 
-            for (; first_ < end_; first_ += dfa_alphabet_, ++index_)
+            for (std::size_t row_ = 1; row_ < rows_; ++row_)
             {
-                observer_ptr<const id_type> second_ = first_ + dfa_alphabet_;
+                observer_ptr<const id_type> ptr_ =
+                    &dfa_[row_ * dfa_alphabet_];
 
-                for (id_type curr_index_ = index_ + 1; second_ < end_;
-                    ++curr_index_, second_ += dfa_alphabet_)
+                for (id_type i_ = *state_index::eol; i_ < dfa_alphabet_; ++i_)
                 {
-                    if (index_set_.find(curr_index_) != index_set_.end())
+                    if (ptr_[i_])
                     {
-                        continue;
+                        refiner_.add(i_, static_cast<id_type>(row_ - 1),
+                            ptr_[i_] - 1);
                     }
+                }
+            }
 
-                    // Some systems have memcmp in namespace std.
-                    using namespace std;
+            const id_type_vector block_ = refiner_.refine();
+            const std::size_t states_ =
+                *std::max_element(block_.cbegin(), block_.cend()) + 1;
 
-                    if (memcmp(first_, second_, sizeof(id_type) *
-                        dfa_alphabet_) == 0)
-                    {
-                        index_set_.insert(curr_index_);
-                        lookup_ptr_[curr_index_] = new_index_;
-                    }
-                }
+            if (states_ == rows_ - 1)
+                return;
 
-                if (lookup_ptr_[index_] == npos())
+            id_type_vector new_dfa_((states_ + 1) * dfa_alphabet_, 0);
+            std::size_t next_ = 0;
+
+            if (dfa_.front())
+            {
+                new_dfa_.front() = block_[dfa_.front() - 1] + 1;
+            }
+
+            // Blocks are numbered in order of their first row
+            for (std::size_t row_ = 1; row_ < rows_; ++row_)
+            {
+                if (block_[row_ - 1] != next_)
+                    continue;
+
+                observer_ptr<const id_type> ptr_ =
+                    &dfa_[row_ * dfa_alphabet_];
+                observer_ptr<id_type> new_ptr_ =
+                    &new_dfa_[++next_ * dfa_alphabet_];
+
+                std::copy(ptr_, ptr_ + *state_index::eol, new_ptr_);
+
+                for (id_type i_ = *state_index::eol; i_ < dfa_alphabet_; ++i_)
                 {
-                    lookup_ptr_[index_] = new_index_;
-                    ++new_index_;
+                    if (ptr_[i_])
+                    {
+                        new_ptr_[i_] = block_[ptr_[i_] - 1] + 1;
+                    }
                 }
             }
 
-            if (!index_set_.empty())
+            dfa_.swap(new_dfa_);
+        }
+
+        // Weights successors by visits_ if it is not empty.
+        void renumber_dfa(const id_type dfa_alphabet_,
+            const id_type_vector& lookup_,
+            const std::vector<std::size_t>& visits_,
+            id_type_vector& dfa_) const
+        {
+            const std::size_t size_ = dfa_.size() / dfa_alphabet_;
+            // Number of characters (of the first 256) in each column
+            std::vector<std::size_t> weights_(dfa_alphabet_, 0);
+            // Old state number to new and new to old
+            id_type_vector new_index_(size_, npos());
+            id_type_vector old_index_(1, 0);
+            id_type_vector stack_;
+            std::vector<std::pair<std::size_t, id_type>> next_;
+            observer_ptr<const id_type> front_ = &dfa_.front();
+
+            // Nothing to reorder with fewer than three states other than
+            // the 'jam' state.
+            if (size_ < 4)
+                return;
+
+            for (std::size_t c_ = 0; c_ < 256 && c_ < lookup_.size(); ++c_)
             {
-                observer_ptr<const id_type> front_ = &dfa_.front();
-                id_type_vector new_dfa_(front_, front_ + dfa_alphabet_);
-                auto set_end_ = index_set_.cend();
-                observer_ptr<const id_type> ptr_ = front_ + dfa_alphabet_;
-                observer_ptr<id_type> new_ptr_ = nullptr;
+                ++weights_[lookup_[c_]];
+            }
 
-                new_dfa_.resize(size_ - index_set_.size() * dfa_alphabet_, 0);
-                new_ptr_ = &new_dfa_.front() + dfa_alphabet_;
-                size_ /= dfa_alphabet_;
+            new_index_[0] = 0;
 
-                if (bol_index_)
+            // The bol start state follows everything reachable from the
+            // start state, as does any state that is never reached.
+            if (*front_)
+            {
+                stack_.push_back(*front_);
+            }
+
+            for (id_type root_ = 1; root_ < size_; ++root_)
+            {
+                if (new_index_[root_] == npos())
                 {
-                    new_dfa_.front() = lookup_ptr_[bol_index_];
+                    stack_.push_back(root_);
                 }
 
-                for (index_ = 1; index_ < size_; ++index_)
+                while (!stack_.empty())
                 {
-                    if (index_set_.find(index_) != set_end_)
-                    {
-                        ptr_ += dfa_alphabet_;
+                    const id_type state_ = stack_.back();
+                    observer_ptr<const id_type> ptr_ =
+                        front_ + state_ * dfa_alphabet_;
+
+                    stack_.pop_back();
+
+                    if (new_index_[state_] != npos())
                         continue;
-                    }
 
-                    new_ptr_[*state_index::end_state] =
-                        ptr_[*state_index::end_state];
-                    new_ptr_[*state_index::id] = ptr_[*state_index::id];
-                    new_ptr_[*state_index::user_id] =
-                        ptr_[*state_index::user_id];
-                    new_ptr_[*state_index::push_dfa] =
-                        ptr_[*state_index::push_dfa];
-                    new_ptr_[*state_index::next_dfa] =
-                        ptr_[*state_index::next_dfa];
-                    new_ptr_[*state_index::eol] =
-                        lookup_ptr_[ptr_[*state_index::eol]];
-                    new_ptr_ += *state_index::transitions;
-                    ptr_ += *state_index::transitions;
+                    new_index_[state_] =
+                        static_cast<id_type>(old_index_.size());
+                    old_index_.push_back(state_);
+                    next_.clear();
 
                     for (id_type i_ = *state_index::transitions;
                         i_ < dfa_alphabet_; ++i_)
                     {
-                        *new_ptr_++ = lookup_ptr_[*ptr_++];
+                        if (ptr_[i_] != 0 && new_index_[ptr_[i_]] == npos())
+                        {
+                            push_next(next_, ptr_[i_], weights_[i_], visits_);
+                        }
+                    }
+
+                    if (ptr_[*state_index::eol] != 0)
+                    {
+                        push_next(next_, ptr_[*state_index::eol], 0, visits_);
+                    }
+
+                    // The heaviest successor is pushed last, so is next.
+                    // Ties keep the order the generator found them in.
+                    std::sort(next_.begin(), next_.end(),
+                        [](const std::pair<std::size_t, id_type>& lhs_,
+                            const std::pair<std::size_t, id_type>& rhs_)
+                    {
+                        return lhs_.first < rhs_.first ||
+                            (lhs_.first == rhs_.first &&
+                                lhs_.second > rhs_.second);
+                    });
+
+                    for (const auto& pair_ : next_)
+                    {
+                        stack_.push_back(pair_.second);
                     }
                 }
+            }
+
+            id_type_vector new_dfa_(front_, front_ + dfa_alphabet_);
+
+            new_dfa_.resize(dfa_.size(), 0);
+
+            if (*front_)
+            {
+                new_dfa_.front() = new_index_[*front_];
+            }
 
-                dfa_.swap(new_dfa_);
+            for (id_type index_ = 1; index_ < size_; ++index_)
+            {
+                observer_ptr<const id_type> ptr_ =
+                    front_ + old_index_[index_] * dfa_alphabet_;
+                observer_ptr<id_type> new_ptr_ =
+                    &new_dfa_.front() + index_ * dfa_alphabet_;
+
+                new_ptr_[*state_index::end_state] =
+                    ptr_[*state_index::end_state];
+                new_ptr_[*state_index::id] = ptr_[*state_index::id];
+                new_ptr_[*state_index::user_id] = ptr_[*state_index::user_id];
+                new_ptr_[*state_index::push_dfa] =
+                    ptr_[*state_index::push_dfa];
+                new_ptr_[*state_index::next_dfa] =
+                    ptr_[*state_index::next_dfa];
+                new_ptr_[*state_index::eol] =
+                    new_index_[ptr_[*state_index::eol]];
+
+                for (id_type i_ = *state_index::transitions;
+                    i_ < dfa_alphabet_; ++i_)
+                {
+                    new_ptr_[i_] = new_index_[ptr_[i_]];
+                }
+            }
+
+            dfa_.swap(new_dfa_);
+        }
+
+        // States that were profiled but never entered are left for last.
+        static void push_next(std::vector<std::pair<std::size_t, id_type>>&
+            next_, const id_type state_, const std::size_t weight_,
+            const std::vector<std::size_t>& visits_)
+        {
+            if (visits_.empty())
+            {
+                next_.emplace_back(weight_, state_);
+            }
+            else if (state_ < visits_.size() && visits_[state_] != 0)
+            {
+                next_.emplace_back(visits_[state_], state_);
             }
         }
     };
@@ -371,23 +548,30 @@ namespace lexertl
             return _sm_vector.empty();
         }
 
-        void minimise()
+        // observer_ (if any) is told how long each DFA took and how many
+        // states it has left.
+        void minimise(const observer_ptr<basic_build_observer<id_type>>
+            observer_ = nullptr)
         {
             const auto dfas_ = static_cast<id_type>(_sm_vector.size());
 
             for (id_type i_ = 0; i_ < dfas_; ++i_)
             {
                 observer_ptr<dfa> dfa_ = &_sm_vector[i_];
+                const auto start_ = observer_ ?
+                    std::chrono::steady_clock::now() :
+                    std::chrono::steady_clock::time_point();
 
                 if (dfa_->size() > 0)
                 {
-                    std::size_t size_ = 0;
+                    minimise_dfa(*dfa_);
+                }
 
-                    do
-                    {
-                        size_ = dfa_->size();
-                        minimise_dfa(*dfa_, size_);
-                    } while (dfa_->size() != size_);
+                if (observer_)
+                {
+                    observer_->phase(i_, build_phase::minimise,
+                        std::chrono::steady_clock::now() - start_);
+                    observer_->states(i_, dfa_->size(), dfa_->size());
                 }
             }
         }
@@ -413,99 +597,134 @@ namespace lexertl
         }
 
     private:
-        using index_set = std::set<id_type>;
-
-        void minimise_dfa(dfa& dfa_, std::size_t size_) const
+        // Merges equivalent states by partition refinement, as for
+        // basic_state_machine. The alphabet is made up of the ranges of
+        // characters that no transition charset splits, plus eol.
+        void minimise_dfa(dfa& dfa_) const
         {
-            observer_ptr<const state> first_ = &dfa_._states.front();
-            observer_ptr<const state> end_ = first_ + size_;
-            id_type index_ = 0;
-            id_type new_index_ = 0;
-            id_type_vector lookup_(size_, npos());
-            observer_ptr<id_type> lookup_ptr_ = &lookup_.front();
-            index_set index_set_;
-
-            for (; first_ != end_; ++first_, ++index_)
+            using key = std::tuple<bool, typename state::push_pop_dfa,
+                id_type, id_type, id_type, id_type>;
+            using refiner = detail::basic_partition_refiner<std::size_t>;
+            const std::size_t size_ = dfa_.size();
+            std::map<key, std::size_t> blocks_;
+            std::vector<std::size_t> initial_;
+            // Where each range of the alphabet starts
+            std::vector<std::size_t> bounds_;
+
+            initial_.reserve(size_);
+
+            for (const state& state_ : dfa_._states)
             {
-                observer_ptr<const state> second_ = first_ + 1;
+                initial_.push_back(blocks_.emplace(key(state_._end_state,
+                    state_._push_pop_dfa, state_._id, state_._user_id,
+                    state_._push_dfa, state_._next_dfa),
+                    blocks_.size()).first->second);
 
-                for (id_type curr_index_ = index_ + 1; second_ != end_;
-                    ++curr_index_, ++second_)
+                for (const auto& tran_ : state_._transitions)
                 {
-                    if (index_set_.find(curr_index_) != index_set_.end())
+                    for (const auto& range_ : tran_.second._ranges)
                     {
-                        continue;
+                        bounds_.push_back(range_.first);
+                        bounds_.push_back(static_cast<std::size_t>
+                            (range_.second) + 1);
                     }
+                }
+            }
 
-                    if (*first_ == *second_)
-                    {
-                        index_set_.insert(curr_index_);
-                        lookup_ptr_[curr_index_] = new_index_;
-                    }
+            std::sort(bounds_.begin(), bounds_.end());
+            bounds_.erase(std::unique(bounds_.begin(), bounds_.end()),
+                bounds_.end());
+
+            refiner refiner_(initial_);
+            const std::size_t eol_ = bounds_.size();
+
+            for (std::size_t index_ = 0; index_ < size_; ++index_)
+            {
+                const state& state_ = dfa_._states[index_];
+
+                if (state_._eol_index != npos())
+                {
+                    refiner_.add(eol_, index_, state_._eol_index);
                 }
 
-                if (lookup_ptr_[index_] == npos())
+                for (const auto& tran_ : state_._transitions)
                 {
-                    lookup_ptr_[index_] = new_index_;
-                    ++new_index_;
+                    for (const auto& range_ : tran_.second._ranges)
+                    {
+                        const auto first_ = std::lower_bound(bounds_.cbegin(),
+                            bounds_.cend(), range_.first);
+                        const auto last_ = std::lower_bound(first_,
+                            bounds_.cend(),
+                            static_cast<std::size_t>(range_.second) + 1);
+
+                        for (auto iter_ = first_; iter_ != last_; ++iter_)
+                        {
+                            refiner_.add(iter_ - bounds_.cbegin(), index_,
+                                tran_.first);
+                        }
+                    }
                 }
             }
 
-            if (!index_set_.empty())
+            const std::vector<std::size_t> block_ = refiner_.refine();
+            const std::size_t states_ =
+                *std::max_element(block_.cbegin(), block_.cend()) + 1;
+
+            if (states_ == size_)
+                return;
+
+            dfa new_dfa_(states_);
+            std::size_t next_ = 0;
+
+            if (dfa_._bol_index != npos())
             {
-                observer_ptr<const state> front_ = &dfa_._states.front();
-                dfa new_dfa_(new_index_);
-                auto set_end_ = index_set_.cend();
-                observer_ptr<const state> ptr_ = front_;
-                observer_ptr<state> new_ptr_ = &new_dfa_._states.front();
+                new_dfa_._bol_index =
+                    static_cast<id_type>(block_[dfa_._bol_index]);
+            }
+
+            // Blocks are numbered in order of their first state
+            for (std::size_t index_ = 0; index_ < size_; ++index_)
+            {
+                if (block_[index_] != next_)
+                    continue;
+
+                const state& state_ = dfa_._states[index_];
+                state& new_state_ = new_dfa_._states[next_++];
 
-                if (dfa_._bol_index != npos())
+                new_state_._end_state = state_._end_state;
+                new_state_._push_pop_dfa = state_._push_pop_dfa;
+                new_state_._id = state_._id;
+                new_state_._user_id = state_._user_id;
+                new_state_._push_dfa = state_._push_dfa;
+                new_state_._next_dfa = state_._next_dfa;
+
+                if (state_._eol_index != npos())
                 {
-                    new_dfa_._bol_index = lookup_ptr_[dfa_._bol_index];
+                    new_state_._eol_index =
+                        static_cast<id_type>(block_[state_._eol_index]);
                 }
 
-                for (index_ = 0; index_ < size_; ++index_)
+                for (const auto& tran_ : state_._transitions)
                 {
-                    if (index_set_.find(index_) != set_end_)
-                    {
-                        ++ptr_;
-                        continue;
-                    }
+                    const auto next_state_ =
+                        static_cast<id_type>(block_[tran_.first]);
+                    auto find_ = new_state_._transitions.find(next_state_);
 
-                    new_ptr_->_end_state = ptr_->_end_state;
-                    new_ptr_->_id = ptr_->_end_state;
-                    new_ptr_->_user_id = ptr_->_user_id;
-                    new_ptr_->_next_dfa = ptr_->_next_dfa;
-
-                    if (ptr_->_eol_index != npos())
+                    // Long hand for performance
+                    if (find_ == new_state_._transitions.end())
                     {
-                        new_ptr_->_eol_index = lookup_ptr_[ptr_->_eol_index];
+                        new_state_._transitions.insert
+                        (id_type_string_token_pair(next_state_,
+                            tran_.second));
                     }
-
-                    for (const auto& tran_ : ptr_->_transitions)
+                    else
                     {
-                        auto find_ = new_ptr_->_transitions.
-                            find(lookup_ptr_[tran_.first]);
-
-                        // Long hand for performance
-                        if (find_ == new_ptr_->_transitions.end())
-                        {
-                            new_ptr_->_transitions.insert
-                            (id_type_string_token_pair
-                            (lookup_ptr_[tran_.first], tran_.second));
-                        }
-                        else
-                        {
-                            find_->second.insert(tran_.second);
-                        }
+                        find_->second.insert(tran_.second);
                     }
-
-                    ++ptr_;
-                    ++new_ptr_;
                 }
-
-                dfa_.swap(new_dfa_);
             }
+
+            dfa_.swap(new_dfa_);
         }
     };
 
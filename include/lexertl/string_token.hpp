@@ -9,6 +9,7 @@
 #include "char_traits.hpp"
 #include "stream_num.hpp"
 
+#include <algorithm>
 #include <ios> // Needed by GCC 4.4
 #include <sstream>
 #include <string>
@@ -93,15 +94,39 @@ namespace lexertl
             _ranges.swap(rhs_._ranges);
         }
 
-        void insert(const basic_string_token& rhs_)
+        // Adds rhs_ without normalising, so that ranges can be gathered
+        // in any order. Call normalise() once they have all been added.
+        void append(const range& rhs_)
         {
-            auto iter_ = rhs_._ranges.cbegin();
-            auto end_ = rhs_._ranges.cend();
+            _ranges.push_back(rhs_);
+        }
 
-            for (; iter_ != end_; ++iter_)
+        void append(const basic_string_token& rhs_)
+        {
+            _ranges.insert(_ranges.end(), rhs_._ranges.cbegin(),
+                rhs_._ranges.cend());
+        }
+
+        // Sorts the ranges and merges any that overlap or are adjacent.
+        void normalise()
+        {
+            std::sort(_ranges.begin(), _ranges.end());
+            coalesce();
+        }
+
+        void insert(const basic_string_token& rhs_)
+        {
+            if (rhs_._ranges.empty())
             {
-                insert(*iter_);
+                return;
             }
+
+            range_vector ranges_(_ranges.size() + rhs_._ranges.size());
+
+            std::merge(_ranges.cbegin(), _ranges.cend(),
+                rhs_._ranges.cbegin(), rhs_._ranges.cend(), ranges_.begin());
+            _ranges.swap(ranges_);
+            coalesce();
         }
 
         // Deliberately pass by value - may modify
@@ -212,8 +237,8 @@ namespace lexertl
             {
                 if (next_ < iter_->first)
                 {
-                    temp_.insert(range(next_,
-                        static_cast<index_type>(iter_->first - 1)));
+                    temp_._ranges.emplace_back(next_,
+                        static_cast<index_type>(iter_->first - 1));
                 }
 
                 if (iter_->second < max_)
@@ -229,7 +254,7 @@ namespace lexertl
 
             if (!finished_)
             {
-                temp_.insert(range(next_, max_));
+                temp_._ranges.emplace_back(next_, max_);
             }
 
             swap(temp_);
@@ -237,94 +262,59 @@ namespace lexertl
 
         void intersect(basic_string_token& rhs_, basic_string_token& overlap_)
         {
-            auto lhs_iter_ = _ranges.begin();
-            auto lhs_end_ = _ranges.end();
-            auto rhs_iter_ = rhs_._ranges.begin();
-            auto rhs_end_ = rhs_._ranges.end();
+            range_vector ranges_;
+            auto lhs_iter_ = _ranges.cbegin();
+            auto lhs_end_ = _ranges.cend();
+            auto rhs_iter_ = rhs_._ranges.cbegin();
+            auto rhs_end_ = rhs_._ranges.cend();
 
             while (lhs_iter_ != lhs_end_ && rhs_iter_ != rhs_end_)
             {
-                if (rhs_iter_->first > lhs_iter_->second)
+                const index_type first_ =
+                    std::max(lhs_iter_->first, rhs_iter_->first);
+                const index_type second_ =
+                    std::min(lhs_iter_->second, rhs_iter_->second);
+
+                if (first_ <= second_)
                 {
-                    ++lhs_iter_;
+                    ranges_.emplace_back(first_, second_);
                 }
-                else if (rhs_iter_->second < lhs_iter_->first)
+
+                // Advance whichever range finishes first
+                if (lhs_iter_->second < rhs_iter_->second)
                 {
-                    ++rhs_iter_;
+                    ++lhs_iter_;
                 }
                 else
                 {
-                    range range_;
-
-                    if (rhs_iter_->first > lhs_iter_->first)
-                    {
-                        range_.first = rhs_iter_->first;
-                    }
-                    else
-                    {
-                        range_.first = lhs_iter_->first;
-                    }
-
-                    if (rhs_iter_->second < lhs_iter_->second)
-                    {
-                        range_.second = rhs_iter_->second;
-                    }
-                    else
-                    {
-                        range_.second = lhs_iter_->second;
-                    }
-
-                    adjust(range_, *this, lhs_iter_, lhs_end_);
-                    adjust(range_, rhs_, rhs_iter_, rhs_end_);
-                    overlap_.insert(range_);
+                    ++rhs_iter_;
                 }
             }
-        }
-
-        void remove(const basic_string_token& rhs_)
-        {
-            auto lhs_iter_ = _ranges.begin();
-            auto lhs_end_ = _ranges.end();
-            auto rhs_iter_ = rhs_._ranges.cbegin();
-            auto rhs_end_ = rhs_._ranges.cend();
 
-            while (lhs_iter_ != lhs_end_ && rhs_iter_ != rhs_end_)
+            if (!ranges_.empty())
             {
-                if (rhs_iter_->first > lhs_iter_->second)
-                {
-                    ++lhs_iter_;
-                }
-                else if (rhs_iter_->second < lhs_iter_->first)
+                subtract(_ranges, ranges_);
+                subtract(rhs_._ranges, ranges_);
+
+                if (overlap_._ranges.empty())
                 {
-                    ++rhs_iter_;
+                    overlap_._ranges.swap(ranges_);
                 }
                 else
                 {
-                    range range_;
-
-                    if (rhs_iter_->first > lhs_iter_->first)
-                    {
-                        range_.first = rhs_iter_->first;
-                    }
-                    else
-                    {
-                        range_.first = lhs_iter_->first;
-                    }
+                    basic_string_token temp_;
 
-                    if (rhs_iter_->second < lhs_iter_->second)
-                    {
-                        range_.second = rhs_iter_->second;
-                    }
-                    else
-                    {
-                        range_.second = lhs_iter_->second;
-                    }
-
-                    adjust(range_, *this, lhs_iter_, lhs_end_);
+                    temp_._ranges.swap(ranges_);
+                    overlap_.insert(temp_);
                 }
             }
         }
 
+        void remove(const basic_string_token& rhs_)
+        {
+            subtract(_ranges, rhs_._ranges);
+        }
+
         static string escape_char(const typename char_traits::index_type ch_)
         {
             string out_;
@@ -406,34 +396,83 @@ namespace lexertl
         }
 
     private:
-        void adjust(const range& range_, basic_string_token& token_,
-            typename range_vector::iterator& iter_,
-            typename range_vector::iterator& end_)
+        // Merges overlapping or adjacent ranges of a sorted range_vector.
+        void coalesce()
         {
-            if (range_.first > iter_->first)
+            if (_ranges.empty())
             {
-                const index_type second_ = iter_->second;
+                return;
+            }
 
-                iter_->second = range_.first - 1;
+            auto out_ = _ranges.begin();
+            auto iter_ = out_ + 1;
+            auto end_ = _ranges.end();
 
-                if (range_.second < second_)
+            for (; iter_ != end_; ++iter_)
+            {
+                // iter_->first - 1 cannot underflow as iter_->first
+                // is at least out_->first.
+                if (iter_->first <= out_->second ||
+                    static_cast<index_type>(iter_->first - 1) <= out_->second)
                 {
-                    range new_range_(static_cast<index_type>(range_.second + 1),
-                        second_);
-
-                    iter_ = token_.insert(new_range_);
-                    end_ = token_._ranges.end();
+                    if (iter_->second > out_->second)
+                    {
+                        out_->second = iter_->second;
+                    }
+                }
+                else
+                {
+                    *++out_ = *iter_;
                 }
             }
-            else if (range_.second < iter_->second)
-            {
-                iter_->first = range_.second + 1;
-            }
-            else
+
+            _ranges.erase(out_ + 1, end_);
+        }
+
+        // Removes rhs_ from lhs_ in a single pass over both.
+        static void subtract(range_vector& lhs_, const range_vector& rhs_)
+        {
+            range_vector ranges_;
+            auto rhs_iter_ = rhs_.cbegin();
+            auto rhs_end_ = rhs_.cend();
+
+            ranges_.reserve(lhs_.size() + rhs_.size());
+
+            for (const auto& range_ : lhs_)
             {
-                iter_ = token_._ranges.erase(iter_);
-                end_ = token_._ranges.end();
+                index_type first_ = range_.first;
+                bool done_ = false;
+
+                while (rhs_iter_ != rhs_end_ && rhs_iter_->second < first_)
+                {
+                    ++rhs_iter_;
+                }
+
+                for (auto iter_ = rhs_iter_; iter_ != rhs_end_ &&
+                    iter_->first <= range_.second; ++iter_)
+                {
+                    if (iter_->first > first_)
+                    {
+                        ranges_.emplace_back(first_,
+                            static_cast<index_type>(iter_->first - 1));
+                    }
+
+                    if (iter_->second >= range_.second)
+                    {
+                        done_ = true;
+                        break;
+                    }
+
+                    first_ = static_cast<index_type>(iter_->second + 1);
+                }
+
+                if (!done_)
+                {
+                    ranges_.emplace_back(first_, range_.second);
+                }
             }
+
+            lhs_.swap(ranges_);
         }
     };
 }
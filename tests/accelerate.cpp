@@ -0,0 +1,110 @@
+// accelerate.cpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Runs skipped by accel_state must give the same tokens as walking the
+// DFA, for every size of exit set. Wide machines get no accel tables.
+#include <lexertl/flat_state_machine.hpp>
+#include <lexertl/generator.hpp>
+#include <lexertl/lookup.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    // Without bol and eol, so that lookup() accelerates
+    const std::size_t flags_ = +lexertl::feature_bit::skip |
+        +lexertl::feature_bit::again | +lexertl::feature_bit::multi_state |
+        +lexertl::feature_bit::advance;
+    using results = lexertl::match_results<const char*, uint16_t, flags_>;
+}
+
+int main()
+{
+    // The first is the closing quote, the rest are excluded from the body
+    const std::string exits_ = "\"$%{}<>@#!~&|;:,?";
+    bool ok_ = true;
+
+    for (std::size_t size_ = 1; size_ <= exits_.size(); ++size_)
+    {
+        lexertl::rules rules_;
+        lexertl::state_machine sm_;
+        std::string body_ = "[^";
+        std::string input_;
+        std::size_t accel_ = 0;
+
+        for (std::size_t i_ = 0; i_ < size_; ++i_)
+        {
+            body_ += '\\';
+            body_ += exits_[i_];
+        }
+
+        rules_.push("\\\"" + body_ + "]*\\\"", 1);
+        rules_.push(".|\\n", 2);
+        lexertl::generator::build(rules_, sm_);
+
+        const lexertl::flat_state_machine flat_(sm_);
+
+        for (const auto& state_ : flat_.data()._accel)
+        {
+            accel_ += !state_.empty();
+        }
+
+        if ((accel_ != 0) !=
+            (size_ <= lexertl::detail::accel_state::max_exit))
+        {
+            std::fprintf(stderr, "%zu exits: %zu accel states\n", size_,
+                accel_);
+            ok_ = false;
+        }
+
+        // Literals long enough to be scanned in blocks, ending on each
+        // exit byte in turn.
+        for (std::size_t i_ = 0; i_ < 40; ++i_)
+        {
+            input_ += '"';
+            input_.append(i_ * 7 % 53, 'a' + i_ % 26);
+            input_ += exits_[i_ % exits_.size()];
+            input_ += "x\"";
+        }
+
+        results lhs_(input_.c_str(), input_.c_str() + input_.size());
+        results rhs_ = lhs_;
+
+        do
+        {
+            lexertl::lookup(sm_, lhs_);
+            lexertl::lookup(flat_, rhs_);
+
+            if (lhs_.id != rhs_.id || lhs_.second != rhs_.second)
+            {
+                std::fprintf(stderr, "%zu exits: tokens differ at %zu\n",
+                    size_, static_cast<std::size_t>(lhs_.first -
+                        input_.c_str()));
+                ok_ = false;
+                break;
+            }
+        } while (lhs_.id != sm_.eoi());
+    }
+
+    lexertl::wrules wrules_;
+    lexertl::wstate_machine wsm_;
+
+    wrules_.push(L"\\\"[^\\\"]*\\\"", 1);
+    lexertl::wgenerator::build(wrules_, wsm_);
+
+    const lexertl::wflat_state_machine wflat_(wsm_);
+
+    if (!wflat_.data()._accel.empty() || !wflat_.data()._accel_bits.empty())
+    {
+        std::fprintf(stderr, "Accel tables built for wchar_t\n");
+        ok_ = false;
+    }
+
+    return ok_ ? 0 : 1;
+}
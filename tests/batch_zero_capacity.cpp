@@ -0,0 +1,69 @@
+// batch_zero_capacity.cpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// tokenise_batch() must refuse a buffer with no capacity rather than
+// consume (and lose) tokens or never reach the end of input.
+#include <lexertl/batch.hpp>
+#include <lexertl/generator.hpp>
+#include <lexertl/runtime_error.hpp>
+#include <lexertl/state_machine.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+int main()
+{
+    lexertl::rules rules_;
+    lexertl::state_machine sm_;
+    const std::string input_ = "ab cd ef";
+    const char* first_ = input_.c_str();
+    const char* last_ = first_ + input_.size();
+    lexertl::ctoken_buffer empty_(0);
+    lexertl::ctoken_buffer buffer_(2);
+    bool threw_ = false;
+    std::size_t tokens_ = 0;
+
+    rules_.push("[a-z]+", 1);
+    rules_.push("\\s+", rules_.skip());
+    lexertl::generator::build(rules_, sm_);
+
+    try
+    {
+        lexertl::tokenise_batch(sm_, first_, last_, empty_);
+    }
+    catch (const lexertl::runtime_error&)
+    {
+        threw_ = true;
+    }
+
+    if (!threw_)
+    {
+        std::fprintf(stderr, "No exception for a zero capacity buffer\n");
+        return 1;
+    }
+
+    if (empty_.size != 0 || empty_.started)
+    {
+        std::fprintf(stderr, "Zero capacity buffer was modified\n");
+        return 1;
+    }
+
+    // The input is untouched, so a usable buffer still gets every token.
+    for (bool more_ = true; more_;)
+    {
+        more_ = lexertl::tokenise_batch(sm_, first_, last_, buffer_);
+        tokens_ += buffer_.size;
+    }
+
+    if (tokens_ != 3)
+    {
+        std::fprintf(stderr, "Expected 3 tokens, got %zu\n", tokens_);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+// lookup_interleaved_profile.cpp
+// Copyright (c) 2026 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Profiling n streams through the interleaved lookup() must count exactly
+// what profiling them one at a time does.
+#include <lexertl/flat_state_machine.hpp>
+#include <lexertl/generator.hpp>
+#include <lexertl/lookup.hpp>
+#include <lexertl/profile.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    const std::size_t flags_ = +lexertl::feature_bit::skip |
+        +lexertl::feature_bit::again | +lexertl::feature_bit::multi_state |
+        +lexertl::feature_bit::advance | +lexertl::feature_bit::profile;
+    using results = lexertl::match_results<const char*, uint16_t, flags_>;
+
+    bool same(const lexertl::profile& lhs_, const lexertl::profile& rhs_)
+    {
+        return lhs_._dfas == rhs_._dfas && lhs_._states == rhs_._states &&
+            lhs_._rules == rhs_._rules && lhs_._examined == rhs_._examined &&
+            lhs_._consumed == rhs_._consumed;
+    }
+
+    template<typename sm_type>
+    bool test(const char* name_, const sm_type& sm_,
+        const std::array<std::string, 3>& inputs_)
+    {
+        lexertl::profile single_;
+        lexertl::profile interleaved_;
+        std::array<results, 3> results_;
+
+        for (const std::string& input_ : inputs_)
+        {
+            results res_(input_.c_str(), input_.c_str() + input_.size());
+
+            res_.profile = &single_;
+
+            do
+            {
+                lexertl::lookup(sm_, res_);
+            } while (res_.id != sm_.eoi());
+        }
+
+        for (std::size_t i_ = 0; i_ < inputs_.size(); ++i_)
+        {
+            results_[i_].reset(inputs_[i_].c_str(),
+                inputs_[i_].c_str() + inputs_[i_].size());
+            results_[i_].profile = &interleaved_;
+        }
+
+        for (;;)
+        {
+            bool done_ = true;
+
+            lexertl::lookup(sm_, results_);
+
+            for (const results& res_ : results_)
+            {
+                done_ = done_ && res_.id == sm_.eoi();
+            }
+
+            if (done_)
+                break;
+        }
+
+        if (!same(single_, interleaved_))
+        {
+            std::fprintf(stderr, "%s: profiles differ (%zu vs %zu starts)\n",
+                name_, single_.starts(0) + single_.starts(1),
+                interleaved_.starts(0) + interleaved_.starts(1));
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main()
+{
+    lexertl::rules rules_;
+    lexertl::state_machine sm_;
+
+    rules_.push_state("COMMENT");
+    rules_.push("INITIAL", "if|else|while", 1, ".");
+    rules_.push("INITIAL", "[a-z_][a-z0-9_]*", 2, ".");
+    rules_.push("INITIAL", "\\d+", 3, ".");
+    rules_.push("INITIAL", "\\s+", rules_.skip(), ".");
+    rules_.push("INITIAL", "\\/\\*", 4, "COMMENT");
+    rules_.push("COMMENT", "[^*]+|\\*", rules_.skip(), ".");
+    rules_.push("COMMENT", "\\*\\/", rules_.skip(), "INITIAL");
+    lexertl::generator::build(rules_, sm_);
+
+    const lexertl::flat_state_machine flat_(sm_);
+    // Differing lengths so that streams finish at different times, and
+    // an empty one.
+    const std::array<std::string, 3> inputs_ = { {
+        "if x1 else /* a * b */ while 42 y",
+        "",
+        "abc 1 2 3 /* unterminated" } };
+    bool ok_ = test("state_machine", sm_, inputs_);
+
+    ok_ = test("flat_state_machine", flat_, inputs_) && ok_;
+    return ok_ ? 0 : 1;
+}